@@ -0,0 +1,550 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common.hpp"
+#include "dynamic_array.hpp"
+#include "scalar.hpp"
+#include "utility.hpp"
+
+
+namespace serialpp {
+
+    /*
+        Bits are packed 8 per byte, with bit i in byte (i / 8) at bit position (i % 8) (i.e. least significant bit
+        first). Unused bits in the last byte are 0.
+
+        static_bitset:
+            Fixed data is the N bits, packed into (N + 7) / 8 bytes.
+
+        bitset_array:
+            Fixed data is a bit count (Format::size_type) and an offset (Format::offset_type).
+            If the bit count is > 0, then the packed bits are contained starting at the offset.
+            If the bit count is 0, then the offset is not significant and no variable data is present.
+    */
+
+
+    namespace detail {
+
+        // Number of bytes required to pack bit_count bits.
+        [[nodiscard]]
+        constexpr std::size_t packed_bits_size(std::size_t const bit_count) noexcept {
+            return bit_count / 8 + (bit_count % 8 != 0);
+        }
+
+
+        // Packs output.size() * 8 bits (or fewer, the last byte padded with 0s) obtained from get_bit(index).
+        template<typename F>
+        constexpr void pack_bits(std::size_t const bit_count, F&& get_bit, mutable_bytes_span const output) {
+            assert(output.size() == packed_bits_size(bit_count));
+            for (std::size_t byte = 0; byte < output.size(); ++byte) {
+                unsigned value = 0;
+                auto const begin = byte * 8;
+                auto const end = std::min(begin + 8, bit_count);
+                for (auto i = begin; i < end; ++i) {
+                    value |= static_cast<unsigned>(static_cast<bool>(get_bit(i))) << (i - begin);
+                }
+                output[byte] = static_cast<std::byte>(value);
+            }
+        }
+
+
+        // Packs bools 8 at a time into output.
+        constexpr void pack_bools(std::span<bool const> const bits, mutable_bytes_span const output) {
+            assert(output.size() == packed_bits_size(bits.size()));
+            std::size_t byte = 0;
+            if constexpr (is_little_endian) {
+                // Load 8 bools as a word, and gather their lowest bits into the top byte with one multiplication.
+                for (; bits.size() - byte * 8 >= 8; ++byte) {
+                    std::array<bool, 8> word_bits{};
+                    std::copy_n(bits.begin() + byte * 8, 8, word_bits.begin());
+                    auto const word = std::bit_cast<std::uint64_t>(word_bits);
+                    output[byte] = static_cast<std::byte>((word * 0x0102'0408'1020'4080ull) >> 56);
+                }
+            }
+            auto const rest = bits.subspan(byte * 8);
+            pack_bits(rest.size(), [rest](std::size_t const i) { return rest[i]; }, output.subspan(byte));
+        }
+
+
+        [[nodiscard]]
+        constexpr bool test_bit(const_bytes_span const bytes, std::size_t const index) noexcept {
+            return ((std::to_integer<unsigned>(bytes[index / 8]) >> (index % 8)) & 1u) != 0;
+        }
+
+
+        // Byte with bits 1 where bits of the last byte of bit_count packed bits are used.
+        [[nodiscard]]
+        constexpr unsigned last_byte_mask(std::size_t const bit_count) noexcept {
+            return bit_count % 8 == 0 ? 0xFFu : (1u << (bit_count % 8)) - 1;
+        }
+
+
+        // Loads 8 bytes as a word, in unspecified byte order.
+        [[nodiscard]]
+        constexpr std::uint64_t load_word(const_bytes_span const bytes, std::size_t const offset) noexcept {
+            std::array<std::byte, 8> word{};
+            std::copy_n(bytes.begin() + offset, 8, word.begin());
+            return std::bit_cast<std::uint64_t>(word);
+        }
+
+
+        // Counts the 1 bits among bit_count packed bits. Bits past bit_count are ignored.
+        [[nodiscard]]
+        constexpr std::size_t count_bits(const_bytes_span const bytes, std::size_t const bit_count) noexcept {
+            auto const size = packed_bits_size(bit_count);
+            std::size_t count = 0;
+            std::size_t byte = 0;
+            // Count a word at a time. Byte order doesn't matter.
+            for (; size - byte > 8; byte += 8) {
+                count += static_cast<std::size_t>(std::popcount(load_word(bytes, byte)));
+            }
+            for (; byte < size; ++byte) {
+                auto value = std::to_integer<unsigned>(bytes[byte]);
+                if (byte + 1 == size) {
+                    value &= last_byte_mask(bit_count);
+                }
+                count += static_cast<std::size_t>(std::popcount(value));
+            }
+            return count;
+        }
+
+
+        // Finds the index of the first 1 bit at or after position among bit_count packed bits. Returns bit_count if
+        // there is none.
+        [[nodiscard]]
+        constexpr std::size_t find_next_bit(const_bytes_span const bytes, std::size_t const bit_count,
+                std::size_t const position) noexcept {
+            if (position >= bit_count) {
+                return bit_count;
+            }
+            auto const size = packed_bits_size(bit_count);
+            auto byte = position / 8;
+            auto const first = std::to_integer<unsigned>(bytes[byte]) >> (position % 8);
+            if (first != 0) {
+                return std::min(position + static_cast<std::size_t>(std::countr_zero(first)), bit_count);
+            }
+            ++byte;
+            // Skip zero bytes a word at a time.
+            while (size - byte >= 8 && load_word(bytes, byte) == 0) {
+                byte += 8;
+            }
+            for (; byte < size; ++byte) {
+                auto const value = std::to_integer<unsigned>(bytes[byte]);
+                if (value != 0) {
+                    return std::min(byte * 8 + static_cast<std::size_t>(std::countr_zero(value)), bit_count);
+                }
+            }
+            return bit_count;
+        }
+
+
+        // For each byte value, the bits expanded to 1 byte each (0 or 1).
+        inline constexpr auto expanded_bits_table = [] {
+            std::array<std::array<std::uint8_t, 8>, 256> table{};
+            for (unsigned value = 0; value < 256; ++value) {
+                for (unsigned bit = 0; bit < 8; ++bit) {
+                    table[value][bit] = static_cast<std::uint8_t>((value >> bit) & 1u);
+                }
+            }
+            return table;
+        }();
+
+
+        // Unpacks the first output.size() packed bits into output, as 0 or 1.
+        template<typename U, std::size_t Extent>
+        constexpr void unpack_bits(const_bytes_span const bytes, std::span<U, Extent> const output) noexcept {
+            std::size_t i = 0;
+            if constexpr (sizeof(U) == 1 && std::is_trivially_copyable_v<U>) {
+                if (!std::is_constant_evaluated()) {
+                    // Expand a whole byte at a time.
+                    for (; output.size() - i >= 8; i += 8) {
+                        auto const& expanded = expanded_bits_table[std::to_integer<unsigned>(bytes[i / 8])];
+                        std::memcpy(output.data() + i, expanded.data(), 8);
+                    }
+                }
+            }
+            for (; i < output.size(); ++i) {
+                output[i] = static_cast<U>(test_bit(bytes, i));
+            }
+        }
+
+    }
+
+
+    // Type which can receive unpacked bits, as 0 or 1 (i.e. false or true).
+    template<typename U>
+    concept unpacked_bit = std::same_as<U, bool> || std::same_as<U, std::uint8_t>;
+
+
+    // Non-owning view of packed bits within a buffer, obtained from the deserialiser of static_bitset or bitset_array.
+    // The bits must already have been bounds checked.
+    class bitset_view {
+    public:
+        bitset_view() = default;
+
+        constexpr bitset_view(const_bytes_span const bytes, std::size_t const size) noexcept :
+            _bytes{bytes}, _size{size}
+        {
+            assert(bytes.size() >= detail::packed_bits_size(size));
+        }
+
+        // Gets the number of bits.
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        // Gets the bit at the specified index. index must be < size().
+        [[nodiscard]]
+        constexpr bool operator[](std::size_t const index) const noexcept {
+            assert(index < _size);
+            return detail::test_bit(_bytes, index);
+        }
+
+        // Gets the bit at the specified index. Throws std::out_of_range if index is out of bounds.
+        [[nodiscard]]
+        constexpr bool test(std::size_t const index) const {
+            if (index < _size) {
+                return (*this)[index];
+            }
+            else {
+                throw std::out_of_range{std::format("index {} is out of bounds for bitset with size {}", index, _size)};
+            }
+        }
+
+        // Counts the number of bits which are set.
+        [[nodiscard]]
+        constexpr std::size_t count() const noexcept {
+            return detail::count_bits(_bytes, _size);
+        }
+
+        // Checks if all bits are set. True if size() == 0.
+        [[nodiscard]]
+        constexpr bool all() const noexcept {
+            return count() == _size;
+        }
+
+        // Checks if any bit is set.
+        [[nodiscard]]
+        constexpr bool any() const noexcept {
+            return find_first() < _size;
+        }
+
+        // Checks if no bit is set.
+        [[nodiscard]]
+        constexpr bool none() const noexcept {
+            return !any();
+        }
+
+        // Gets the index of the first set bit, or size() if no bit is set.
+        [[nodiscard]]
+        constexpr std::size_t find_first() const noexcept {
+            return detail::find_next_bit(_bytes, _size, 0);
+        }
+
+        // Gets the index of the first set bit after position, or size() if there is none.
+        [[nodiscard]]
+        constexpr std::size_t find_next(std::size_t const position) const noexcept {
+            return position + 1 >= _size ? _size : detail::find_next_bit(_bytes, _size, position + 1);
+        }
+
+        // Unpacks all bits into the beginning of output, 1 byte per bit (0 or 1), and returns the part of output which
+        // was written. This is suitable for producing byte masks.
+        // Throws std::out_of_range if output is smaller than size().
+        template<unpacked_bit U, std::size_t Extent>
+        constexpr std::span<U> copy_to(std::span<U, Extent> const output) const {
+            if (output.size() < _size) {
+                throw std::out_of_range{
+                    std::format("output of size {} is too small for bitset with size {}", output.size(), _size)};
+            }
+            auto const written = output.first(_size);
+            detail::unpack_bits(_bytes, written);
+            return written;
+        }
+
+        // Unpacks all bits into a new std::vector.
+        template<unpacked_bit U = bool>
+        [[nodiscard]]
+        constexpr std::vector<U> to_vector() const {
+            std::vector<U> result(_size);
+            if constexpr (std::same_as<U, bool>) {
+                // std::vector<bool> isn't contiguous.
+                for (std::size_t i = 0; i < _size; ++i) {
+                    result[i] = (*this)[i];
+                }
+            }
+            else {
+                (void)copy_to(std::span{result});
+            }
+            return result;
+        }
+
+    private:
+        const_bytes_span _bytes;
+        std::size_t _size = 0;
+    };
+
+
+    // Serialisable fixed-size sequence of N bits, packed 8 per byte.
+    template<std::size_t N>
+    struct static_bitset {
+        static constexpr std::size_t size = N;
+    };
+
+
+    template<std::size_t N>
+    struct fixed_data_size<static_bitset<N>> : detail::size_t_constant<detail::packed_bits_size(N)> {};
+
+
+    template<std::size_t N>
+    class serialise_source<static_bitset<N>> : public std::bitset<N> {
+    public:
+        using std::bitset<N>::bitset;
+
+        constexpr serialise_source(std::bitset<N> const& bits) noexcept :
+            std::bitset<N>{bits}
+        {}
+    };
+
+
+    template<std::size_t N>
+    struct serialiser<static_bitset<N>> {
+        static constexpr void serialise(serialise_source<static_bitset<N>> const& source,
+                serialise_buffer auto& buffer, std::size_t const fixed_offset) {
+            serialise(source, buffer.span(), fixed_offset);
+        }
+
+        static constexpr void serialise(serialise_source<static_bitset<N>> const& source,
+                mutable_bytes_span const buffer, std::size_t const fixed_offset) {
+            auto const output = buffer.subspan(fixed_offset, fixed_data_size_v<static_bitset<N>>);
+            if constexpr (N <= 64) {
+                // All bits fit in a word.
+                auto word = source.to_ullong();
+                for (auto& byte : output) {
+                    byte = static_cast<std::byte>(word & 0xFFu);
+                    word >>= 8;
+                }
+            }
+            else {
+                detail::pack_bits(N, [&source](std::size_t const i) { return source[i]; }, output);
+            }
+        }
+    };
+
+
+    template<std::size_t N>
+    class deserialiser<static_bitset<N>> : public deserialiser_base {
+    public:
+        using deserialiser_base::deserialiser_base;
+
+        [[nodiscard]]
+        static constexpr std::size_t size() noexcept {
+            return N;
+        }
+
+        // Gets the bit at the specified index. index must be < size().
+        [[nodiscard]]
+        constexpr bool operator[](std::size_t const index) const {
+            return bits()[index];
+        }
+
+        // Gets a view of the bits, which provides bit counting, searching and unpacking.
+        [[nodiscard]]
+        constexpr bitset_view bits() const {
+            return bitset_view{_fixed_data().first(fixed_data_size_v<static_bitset<N>>), N};
+        }
+
+        // Deserialises all bits into a new std::bitset.
+        [[nodiscard]]
+        constexpr std::bitset<N> to_bitset() const {
+            auto const bits = this->bits();
+            std::bitset<N> result;
+            for (auto i = bits.find_first(); i < N; i = bits.find_next(i)) {
+                result.set(i);
+            }
+            return result;
+        }
+    };
+
+
+    // Serialisable variable-length sequence of bits, packed 8 per byte. Can hold up to
+    // basic_max_dynamic_array_size<Format> bits.
+    // Format determines the size of the bit count and offset (see format_profile).
+    template<format_profile Format = compact_format>
+    struct bitset_array {
+        using format = Format;
+    };
+
+
+    template<format_profile Format>
+    struct fixed_data_size<bitset_array<Format>> : detail::size_t_constant<
+        fixed_data_size_v<typename Format::size_type> + fixed_data_size_v<typename Format::offset_type>> {};
+
+
+    // Constructible from a braced-init-list of bools or a std::vector<bool> rvalue (which are owned), or a
+    // std::vector<bool> lvalue or std::span of bools (which are referenced).
+    // Spans of bools are packed a word at a time, which is faster than std::vector<bool>.
+    template<format_profile Format>
+    class serialise_source<bitset_array<Format>> {
+    public:
+        // Constructs with zero bits.
+        constexpr serialise_source() = default;
+
+        constexpr serialise_source(std::initializer_list<bool> const bits) :
+            _bits{std::in_place_type<std::vector<bool>>, bits}
+        {}
+
+        constexpr serialise_source(std::vector<bool>&& bits) noexcept :
+            _bits{std::in_place_type<std::vector<bool>>, std::move(bits)}
+        {}
+
+        // bits must outlive this object.
+        constexpr serialise_source(std::vector<bool> const& bits) noexcept :
+            _bits{std::in_place_type<std::vector<bool> const*>, &bits}
+        {}
+
+        // bits must outlive this object.
+        constexpr serialise_source(std::span<bool const> const bits) noexcept :
+            _bits{std::in_place_type<std::span<bool const>>, bits}
+        {}
+
+        // Gets the number of bits.
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return std::visit([](auto const& bits) {
+                if constexpr (std::is_pointer_v<std::remove_cvref_t<decltype(bits)>>) {
+                    return bits->size();
+                }
+                else {
+                    return bits.size();
+                }
+            }, _bits);
+        }
+
+        // Packs the bits into output, which must have exactly enough space for them.
+        constexpr void pack(mutable_bytes_span const output) const {
+            std::visit([output](auto const& bits) {
+                using bits_type = std::remove_cvref_t<decltype(bits)>;
+                if constexpr (std::same_as<bits_type, std::span<bool const>>) {
+                    detail::pack_bools(bits, output);
+                }
+                else {
+                    auto const& vector = _vector(bits);
+                    detail::pack_bits(vector.size(), [&vector](std::size_t const i) { return vector[i]; }, output);
+                }
+            }, _bits);
+        }
+
+    private:
+        std::variant<std::span<bool const>, std::vector<bool>, std::vector<bool> const*> _bits;
+
+        [[nodiscard]]
+        static constexpr std::vector<bool> const& _vector(std::vector<bool> const& bits) noexcept {
+            return bits;
+        }
+
+        [[nodiscard]]
+        static constexpr std::vector<bool> const& _vector(std::vector<bool> const* const bits) noexcept {
+            return *bits;
+        }
+    };
+
+
+    template<format_profile Format>
+    struct serialiser<bitset_array<Format>> {
+        static constexpr void serialise(serialise_source<bitset_array<Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            using size_type = Format::size_type;
+            using offset_type = Format::offset_type;
+
+            auto const bit_count = source.size();
+            auto const count = detail::to_size_type<Format>(bit_count, "bitset_array bit count");
+            offset_type offset = 0;
+            if (bit_count > 0) {
+                auto const byte_count = detail::packed_bits_size(bit_count);
+                auto const bytes_offset = push_variable_subobjects<std::byte>(byte_count, buffer,
+                    [&buffer, &source, byte_count](std::size_t const bytes_offset) {
+                        source.pack(buffer.span().subspan(bytes_offset, byte_count));
+                    });
+                offset = detail::to_data_offset<offset_type>(bytes_offset);
+            }
+
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<size_type>{count}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{offset}, buffer));
+        }
+
+        static constexpr std::size_t variable_data_size(serialise_source<bitset_array<Format>> const& source) {
+            return detail::packed_bits_size(source.size());
+        }
+    };
+
+
+    template<format_profile Format>
+    class deserialiser<bitset_array<Format>> : public deserialiser_base {
+    public:
+        using deserialiser_base::deserialiser_base;
+
+        // Gets the number of bits.
+        [[nodiscard]]
+        constexpr std::size_t size() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
+        }
+
+        // Checks if there are zero bits.
+        [[nodiscard]]
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        // Gets the bit at the specified index. index must be < size().
+        [[nodiscard]]
+        constexpr bool operator[](std::size_t const index) const {
+            return bits()[index];
+        }
+
+        // Gets a view of the bits, which provides bit counting, searching and unpacking.
+        // Throws buffer_bounds_error if the bits are out of bounds.
+        [[nodiscard]]
+        constexpr bitset_view bits() const {
+            auto const size = this->size();
+            if (size == 0) {
+                return {};
+            }
+            auto const offset_offset = _fixed_offset + fixed_data_size_v<typename Format::size_type>;
+            auto const offset = static_cast<std::size_t>(_deserialise<typename Format::offset_type>(offset_offset));
+            auto const byte_count = detail::packed_bits_size(size);
+            // Always bounds checked, since the view relies on it.
+            if (offset > _buffer.size() || _buffer.size() - offset < byte_count) {
+                throw buffer_bounds_error{
+                    std::format("Data buffer of size {} is too small to deserialise {} bits at offset {}",
+                        _buffer.size(), size, offset)};
+            }
+            return bitset_view{_buffer.subspan(offset, byte_count), size};
+        }
+
+        // Checks that the bits are within the buffer.
+        constexpr void validate_subobjects(parallel_executor const* = nullptr) const {
+            (void)bits();
+        }
+    };
+
+}
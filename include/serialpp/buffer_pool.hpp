@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "buffers.hpp"
+#include "common.hpp"
+
+
+namespace serialpp {
+
+    class buffer_pool;
+
+
+    // serialise_buffer implementation which is checked out of a buffer_pool.
+    // On destruction, the underlying storage is returned to the pool (keeping its capacity) to be reused by later
+    // serialisations.
+    class pooled_buffer {
+    public:
+        pooled_buffer(pooled_buffer&& other) noexcept :
+            _pool{std::exchange(other._pool, nullptr)},
+            _buffer{std::move(other._buffer)},
+            _size_class{other._size_class}
+        {}
+
+        ~pooled_buffer();
+
+        pooled_buffer& operator=(pooled_buffer other) noexcept {
+            swap(*this, other);
+            return *this;
+        }
+
+        // Sets the size in bytes of the buffer, ready for a new serialisation.
+        // Same semantics as basic_buffer::initialise().
+        mutable_bytes_span initialise(std::size_t const size) {
+            return _buffer.initialise(size);
+        }
+
+        // Extends the buffer by count bytes, while maintaining the previous content.
+        // Same semantics as basic_buffer::extend().
+        mutable_bytes_span extend(std::size_t const count) {
+            return _buffer.extend(count);
+        }
+
+        // Shrinks the buffer to size bytes, keeping the previous content before size.
+        // Same semantics as basic_buffer::truncate().
+        mutable_bytes_span truncate(std::size_t const size) noexcept {
+            return _buffer.truncate(size);
+        }
+
+        [[nodiscard]]
+        const_bytes_span span() const noexcept {
+            return _buffer.span();
+        }
+
+        [[nodiscard]]
+        mutable_bytes_span span() noexcept {
+            return _buffer.span();
+        }
+
+        [[nodiscard]]
+        std::size_t capacity() const noexcept {
+            return _buffer.capacity();
+        }
+
+        friend void swap(pooled_buffer& first, pooled_buffer& second) noexcept {
+            using std::swap;
+            swap(first._pool, second._pool);
+            swap(first._buffer, second._buffer);
+            swap(first._size_class, second._size_class);
+        }
+
+    private:
+        friend class buffer_pool;
+
+        buffer_pool* _pool;
+        basic_buffer _buffer;
+        std::size_t _size_class;        // Size class the buffer was checked out from.
+
+        pooled_buffer(buffer_pool& pool, basic_buffer buffer, std::size_t const size_class) noexcept :
+            _pool{&pool}, _buffer{std::move(buffer)}, _size_class{size_class}
+        {}
+    };
+
+
+    // Thread-safe pool of reusable serialisation buffers.
+    // Buffers are grouped into power-of-two size classes by capacity. Idle buffers are kept in a number of shards, each
+    // with its own lock, and each thread prefers a particular shard, so threads rarely contend with each other.
+    // Reused buffers are not reinitialised, so in the steady state, acquiring a buffer doesn't allocate memory.
+    // The pool must outlive all buffers acquired from it.
+    class buffer_pool {
+    public:
+        // Smallest capacity of buffers allocated by the pool.
+        static constexpr std::size_t min_capacity = 4096;
+
+        // shard_count is the number of independently locked shards of idle buffers. The default is one per hardware
+        // thread.
+        explicit buffer_pool(std::size_t const shard_count = std::max(std::thread::hardware_concurrency(), 1u)) :
+            _shards{new _shard[std::max<std::size_t>(shard_count, 1)]},
+            _shard_count{std::max<std::size_t>(shard_count, 1)},
+            _outstanding{},
+            _high_water_marks{}
+        {}
+
+        buffer_pool(buffer_pool const&) = delete;
+        buffer_pool& operator=(buffer_pool const&) = delete;
+
+        // Checks out a buffer with at least the specified capacity.
+        // An idle buffer is reused if one is available, otherwise a new one is allocated (without preloading).
+        // Throws std::bad_alloc if capacity is greater than the largest size class (2^63 bytes on 64-bit platforms).
+        [[nodiscard]]
+        pooled_buffer acquire(std::size_t const capacity = 0) {
+            if (capacity > _class_capacity(_size_class_count - 1)) {
+                throw std::bad_alloc{};
+            }
+            auto const size_class = _size_class_for(capacity);
+            auto& shard = _local_shard();
+            std::optional<basic_buffer> buffer;
+            {
+                std::lock_guard const lock{shard.mutex};
+                // Also accept somewhat larger buffers, which may have grown while checked out.
+                auto const last_class = std::min(size_class + 2, _size_class_count - 1);
+                for (auto c = size_class; c <= last_class && !buffer; ++c) {
+                    auto& idle = shard.idle_buffers[c];
+                    if (!idle.empty()) {
+                        buffer.emplace(std::move(idle.back()));
+                        idle.pop_back();
+                    }
+                }
+            }
+            if (!buffer) {
+                buffer.emplace(_class_capacity(size_class), false);
+            }
+
+            auto const outstanding = _outstanding[size_class].fetch_add(1, std::memory_order_relaxed) + 1;
+            auto& high_water_mark = _high_water_marks[size_class];
+            auto current_mark = high_water_mark.load(std::memory_order_relaxed);
+            while (current_mark < outstanding
+                    && !high_water_mark.compare_exchange_weak(current_mark, outstanding, std::memory_order_relaxed)) {}
+
+            return pooled_buffer{*this, std::move(*buffer), size_class};
+        }
+
+        // Gets the greatest number of buffers from the size class for capacity which have been checked out at once.
+        [[nodiscard]]
+        std::size_t high_water_mark(std::size_t const capacity) const noexcept {
+            return _high_water_marks[_size_class_for(capacity)].load(std::memory_order_relaxed);
+        }
+
+        // Gets the number of buffers from the size class for capacity which are currently checked out.
+        [[nodiscard]]
+        std::size_t outstanding(std::size_t const capacity) const noexcept {
+            return _outstanding[_size_class_for(capacity)].load(std::memory_order_relaxed);
+        }
+
+        // Frees all idle buffers.
+        void clear() noexcept {
+            for (std::size_t i = 0; i < _shard_count; ++i) {
+                auto& shard = _shards[i];
+                std::lock_guard const lock{shard.mutex};
+                for (auto& idle : shard.idle_buffers) {
+                    idle.clear();
+                }
+            }
+        }
+
+    private:
+        friend class pooled_buffer;
+
+        static constexpr std::size_t _min_size_class_log2 = std::bit_width(min_capacity) - 1;
+        // The largest size class has capacity 2^(bits in std::size_t - 1).
+        static constexpr std::size_t _size_class_count =
+            std::numeric_limits<std::size_t>::digits - _min_size_class_log2;
+
+        // Avoid false sharing between shards used by different threads.
+        struct alignas(64) _shard {
+            std::mutex mutex;
+            std::array<std::vector<basic_buffer>, _size_class_count> idle_buffers;
+        };
+
+        std::unique_ptr<_shard[]> _shards;
+        std::size_t _shard_count;
+        std::array<std::atomic<std::size_t>, _size_class_count> _outstanding;
+        std::array<std::atomic<std::size_t>, _size_class_count> _high_water_marks;
+
+        // Gets the smallest size class whose buffers have at least capacity bytes.
+        [[nodiscard]]
+        static constexpr std::size_t _size_class_for(std::size_t const capacity) noexcept {
+            auto const log2 = capacity <= min_capacity ? _min_size_class_log2 : std::bit_width(capacity - 1);
+            return std::min<std::size_t>(log2 - _min_size_class_log2, _size_class_count - 1);
+        }
+
+        [[nodiscard]]
+        static constexpr std::size_t _class_capacity(std::size_t const size_class) noexcept {
+            return std::size_t{1} << (size_class + _min_size_class_log2);
+        }
+
+        [[nodiscard]]
+        _shard& _local_shard() noexcept {
+            return _shards[std::hash<std::thread::id>{}(std::this_thread::get_id()) % _shard_count];
+        }
+
+        // Returns a buffer which was checked out from size_class.
+        void _release(basic_buffer buffer, std::size_t const size_class) noexcept {
+            _outstanding[size_class].fetch_sub(1, std::memory_order_relaxed);
+            auto const capacity = buffer.capacity();
+            if (capacity < min_capacity) {
+                // Moved-from or otherwise unusable.
+                return;
+            }
+            // File under the largest class whose capacity the buffer fully satisfies.
+            auto const log2 = static_cast<std::size_t>(std::bit_width(capacity) - 1);
+            auto const storage_class = std::min(log2 - _min_size_class_log2, _size_class_count - 1);
+            auto& shard = _local_shard();
+            std::lock_guard const lock{shard.mutex};
+            try {
+                shard.idle_buffers[storage_class].push_back(std::move(buffer));
+            }
+            catch (std::bad_alloc const&) {
+                // Can't keep the buffer, just free it.
+            }
+        }
+    };
+
+
+    inline pooled_buffer::~pooled_buffer() {
+        if (_pool) {
+            _pool->_release(std::move(_buffer), _size_class);
+        }
+    }
+
+}
@@ -4,7 +4,13 @@
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ranges>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "common.hpp"
 #include "utility.hpp"
@@ -12,33 +18,163 @@
 
 namespace serialpp {
 
-    // Basic serialise_buffer implementation that uses the frestore (new/delete) for storage.
-    // Reallocations are done as necessary to extend the buffer while serialising.
-    class basic_buffer {
+    // Policy for how much memory an allocating_buffer allocates.
+    // initial_capacity(size) is the capacity to allocate when the buffer is initialised to size bytes and size exceeds
+    // the current capacity.
+    // grown_capacity(capacity, size) is the capacity to allocate when the buffer is extended to size bytes and size
+    // exceeds the current capacity.
+    // Both must return at least size.
+    template<typename G>
+    concept buffer_growth_policy = std::copyable<G> && requires(G const growth, std::size_t const size) {
+        { growth.initial_capacity(size) } -> std::same_as<std::size_t>;
+        { growth.grown_capacity(size, size) } -> std::same_as<std::size_t>;
+    };
+
+
+    // Grows the capacity to Numerator / Denominator times the required size when extending, so that the cost of
+    // reallocations is amortised. Initialises to exactly the required size.
+    template<std::size_t Numerator = 3, std::size_t Denominator = 2>
+        requires (Denominator > 0) && (Numerator >= Denominator)
+    struct geometric_growth {
+        [[nodiscard]]
+        constexpr std::size_t initial_capacity(std::size_t const size) const noexcept {
+            return size;
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t grown_capacity(std::size_t, std::size_t const size) const noexcept {
+            // Avoids overflowing for large sizes.
+            return size / Denominator * Numerator + size % Denominator * Numerator / Denominator;
+        }
+    };
+
+
+    // Grows the capacity by a fixed number of bytes (or to the required size, if greater) when extending.
+    // Initialises to exactly the required size.
+    struct fixed_growth {
+        std::size_t increment = 4096;
+
+        [[nodiscard]]
+        constexpr std::size_t initial_capacity(std::size_t const size) const noexcept {
+            return size;
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t grown_capacity(std::size_t const capacity, std::size_t const size) const noexcept {
+            return std::max(capacity + increment, size);
+        }
+    };
+
+
+    // Always allocates exactly the required size. Minimises memory usage, but every extension beyond the capacity
+    // reallocates.
+    struct exact_growth {
+        [[nodiscard]]
+        constexpr std::size_t initial_capacity(std::size_t const size) const noexcept {
+            return size;
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t grown_capacity(std::size_t, std::size_t const size) const noexcept {
+            return size;
+        }
+    };
+
+
+    // Rounds the capacities chosen by Base up to a whole number of pages, or of huge pages for capacities of at least
+    // one huge page. With such sizes, the memory can be backed by whole (huge) pages with no waste (e.g. via
+    // madvise(MADV_HUGEPAGE) on Linux, or an allocator which maps memory directly).
+    template<buffer_growth_policy Base = geometric_growth<>>
+    struct page_rounded_growth {
+        std::size_t page_size = 4096;
+        std::size_t huge_page_size = 2 * 1024 * 1024;
+        [[no_unique_address]] Base base{};
+
+        [[nodiscard]]
+        constexpr std::size_t initial_capacity(std::size_t const size) const {
+            return _round(base.initial_capacity(size));
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t grown_capacity(std::size_t const capacity, std::size_t const size) const {
+            return _round(base.grown_capacity(capacity, size));
+        }
+
+    private:
+        [[nodiscard]]
+        constexpr std::size_t _round(std::size_t const size) const noexcept {
+            auto const granularity = size >= huge_page_size ? huge_page_size : page_size;
+            if (granularity == 0) {
+                return size;
+            }
+            return (size + granularity - 1) / granularity * granularity;
+        }
+    };
+
+
+    // serialise_buffer implementation that allocates its storage with an allocator (e.g. a std::pmr arena), and
+    // reallocates as necessary to extend the buffer while serialising. GrowthPolicy determines the amount of memory
+    // allocated (see buffer_growth_policy).
+    template<typename Allocator = std::allocator<std::byte>, buffer_growth_policy GrowthPolicy = geometric_growth<>>
+    class allocating_buffer {
     public:
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<std::byte>;
+        using growth_policy_type = GrowthPolicy;
+
         // capacity is the number of bytes to preallocate (similar to std::vector's capacity).
         // If preload is true, force the memory to be loaded into the process now. Otherwise, it may not be loaded until
-        // the buffer is written to.
-        explicit constexpr basic_buffer(std::size_t const capacity = 4096, bool const preload = true) :
-            _data{new std::byte[capacity]},
+        // the buffer is written to. By default, memory is only preloaded with std::allocator, since memory from other
+        // allocators (e.g. a recycled arena) has usually been touched already.
+        explicit constexpr allocating_buffer(std::size_t const capacity = 4096,
+                bool const preload = std::same_as<allocator_type, std::allocator<std::byte>>,
+                Allocator const& allocator = Allocator{}, GrowthPolicy const growth = GrowthPolicy{}) :
+            _allocator{allocator},
+            _growth{growth},
+            _data{_allocate(capacity)},
             _capacity{capacity},
             _used{0}
         {
             if (preload) {
                 // Initialising the memory forces the OS to load it in now, rather than later during serialisation.
                 // This reduces latency when serialising into this buffer for the first time.
-                std::fill_n(_data.get(), _capacity, std::byte{0});
+                std::fill_n(_data, _capacity, std::byte{0});
             }
         }
 
-        constexpr basic_buffer(basic_buffer&& other) noexcept :
+        constexpr allocating_buffer(allocating_buffer&& other) noexcept :
+            _allocator{other._allocator},
+            _growth{other._growth},
             _data{std::exchange(other._data, nullptr)},
             _capacity{std::exchange(other._capacity, 0)},
             _used{std::exchange(other._used, 0)}
         {}
 
-        constexpr basic_buffer& operator=(basic_buffer other) noexcept {
-            swap(*this, other);
+        constexpr ~allocating_buffer() {
+            _deallocate();
+        }
+
+        // If the allocator doesn't propagate and isn't equal to other's, other's content is copied (like std::vector).
+        constexpr allocating_buffer& operator=(allocating_buffer&& other)
+                noexcept(_allocator_traits::propagate_on_container_move_assignment::value
+                    || _allocator_traits::is_always_equal::value) {
+            if (this != &other) {
+                if constexpr (_allocator_traits::propagate_on_container_move_assignment::value) {
+                    _deallocate();
+                    _allocator = other._allocator;
+                    _take(other);
+                }
+                else {
+                    if (_allocator == other._allocator) {
+                        _deallocate();
+                        _take(other);
+                    }
+                    else {
+                        initialise(other._used);
+                        std::copy_n(other._data, other._used, _data);
+                    }
+                }
+                _growth = other._growth;
+            }
             return *this;
         }
 
@@ -48,8 +184,12 @@ namespace serialpp {
         // Returns the new value of span().
         constexpr mutable_bytes_span initialise(std::size_t const size) {
             if (_capacity < size) {
-                _data.reset(new std::byte[size]);
-                _capacity = size;
+                auto const new_capacity = _growth.initial_capacity(size);
+                assert(new_capacity >= size);
+                auto const new_data = _allocate(new_capacity);
+                _deallocate();
+                _data = new_data;
+                _capacity = new_capacity;
             }
             _used = size;
             return span();
@@ -62,26 +202,36 @@ namespace serialpp {
         constexpr mutable_bytes_span extend(std::size_t const count) {
             auto const new_used = _used + count;
             if (_capacity < new_used) {
-                auto const new_capacity = static_cast<std::size_t>(new_used * 1.5);
-                detail::constexpr_unique_ptr<std::byte[]> new_data{new std::byte[new_capacity]};
+                auto const new_capacity = _growth.grown_capacity(_capacity, new_used);
+                assert(new_capacity >= new_used);
+                auto const new_data = _allocate(new_capacity);
                 assert(_data || _used == 0);
-                std::copy_n(_data.get(), _used, new_data.get());
+                std::copy_n(_data, _used, new_data);
                 // Take ownership of new data last - strong exception guarantee.
-                _data = std::move(new_data);
+                _deallocate();
+                _data = new_data;
                 _capacity = new_capacity;
             }
             _used = new_used;
             return span();
         }
 
+        // Shrinks the buffer to size bytes, keeping the previous content before size. Never reallocates.
+        // Returns the new value of span().
+        constexpr mutable_bytes_span truncate(std::size_t const size) noexcept {
+            assert(size <= _used);
+            _used = size;
+            return span();
+        }
+
         [[nodiscard]]
         constexpr const_bytes_span span() const noexcept {
-            return {_data.get(), _used};
+            return {_data, _used};
         }
 
         [[nodiscard]]
         constexpr mutable_bytes_span span() noexcept {
-            return {_data.get(), _used};
+            return {_data, _used};
         }
 
         [[nodiscard]]
@@ -89,22 +239,284 @@ namespace serialpp {
             return _capacity;
         }
 
-        friend constexpr void swap(basic_buffer& first, basic_buffer& second) noexcept {
+        [[nodiscard]]
+        constexpr allocator_type get_allocator() const noexcept {
+            return _allocator;
+        }
+
+        [[nodiscard]]
+        constexpr GrowthPolicy const& growth_policy() const noexcept {
+            return _growth;
+        }
+
+        // If the allocator doesn't propagate on swap, the allocators must be equal (like std::vector).
+        friend constexpr void swap(allocating_buffer& first, allocating_buffer& second) noexcept {
             using std::swap;
+            if constexpr (_allocator_traits::propagate_on_container_swap::value) {
+                swap(first._allocator, second._allocator);
+            }
+            else {
+                assert(first._allocator == second._allocator);
+            }
+            swap(first._growth, second._growth);
             swap(first._data, second._data);
             swap(first._capacity, second._capacity);
             swap(first._used, second._used);
         }
 
     private:
-        detail::constexpr_unique_ptr<std::byte[]> _data;
+        using _allocator_traits = std::allocator_traits<allocator_type>;
+
+        static_assert(std::is_same_v<typename _allocator_traits::pointer, std::byte*>,
+            "Allocators with fancy pointers are not supported");
+
+        [[no_unique_address]] allocator_type _allocator;
+        [[no_unique_address]] GrowthPolicy _growth;
+        std::byte* _data;
         std::size_t _capacity;      // Number of bytes allocated.
         std::size_t _used;          // Number of bytes used at the start of the allocated memory.
+
+        [[nodiscard]]
+        constexpr std::byte* _allocate(std::size_t const size) {
+            auto const data = _allocator_traits::allocate(_allocator, size);
+            if (std::is_constant_evaluated()) {
+                // At compile time, the bytes' lifetimes must be started explicitly.
+                for (std::size_t i = 0; i < size; ++i) {
+                    std::construct_at(data + i);
+                }
+            }
+            return data;
+        }
+
+        constexpr void _deallocate() noexcept {
+            if (_data) {
+                _allocator_traits::deallocate(_allocator, _data, _capacity);
+                _data = nullptr;
+            }
+        }
+
+        constexpr void _take(allocating_buffer& other) noexcept {
+            _data = std::exchange(other._data, nullptr);
+            _capacity = std::exchange(other._capacity, 0);
+            _used = std::exchange(other._used, 0);
+        }
     };
 
 
+    // Basic serialise_buffer implementation that uses the freestore (new/delete) for storage.
+    // Reallocations are done as necessary to extend the buffer while serialising.
+    using basic_buffer = allocating_buffer<>;
+
+
+    namespace pmr {
+
+        // allocating_buffer which allocates from a std::pmr::memory_resource.
+        template<buffer_growth_policy GrowthPolicy = geometric_growth<>>
+        using allocating_buffer = serialpp::allocating_buffer<std::pmr::polymorphic_allocator<std::byte>, GrowthPolicy>;
+
+    }
+
+
+    // serialise_buffer implementation that uses a fixed region of caller-owned memory for storage.
+    // Never reallocates. If the memory region is too small, std::bad_alloc is thrown.
+    class span_buffer {
+    public:
+        // storage is the memory region to serialise into. It must outlive this buffer.
+        explicit constexpr span_buffer(mutable_bytes_span const storage) noexcept :
+            _storage{storage},
+            _used{0}
+        {}
+
+        // Sets the size in bytes of the buffer, ready for a new serialisation.
+        // If size is greater than the capacity, std::bad_alloc is thrown.
+        // Returns the new value of span().
+        constexpr mutable_bytes_span initialise(std::size_t const size) {
+            if (_storage.size() < size) {
+                throw std::bad_alloc{};
+            }
+            _used = size;
+            return span();
+        }
+
+        // Extends the buffer by count bytes, while maintaining the previous content.
+        // If the new size is greater than the capacity, std::bad_alloc is thrown.
+        // Returns the new value of span().
+        constexpr mutable_bytes_span extend(std::size_t const count) {
+            if (_storage.size() - _used < count) {
+                throw std::bad_alloc{};
+            }
+            _used += count;
+            return span();
+        }
+
+        // Shrinks the buffer to size bytes, keeping the previous content before size.
+        // Returns the new value of span().
+        constexpr mutable_bytes_span truncate(std::size_t const size) noexcept {
+            assert(size <= _used);
+            _used = size;
+            return span();
+        }
+
+        [[nodiscard]]
+        constexpr const_bytes_span span() const noexcept {
+            return _storage.first(_used);
+        }
+
+        [[nodiscard]]
+        constexpr mutable_bytes_span span() noexcept {
+            return _storage.first(_used);
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t capacity() const noexcept {
+            return _storage.size();
+        }
+
+    private:
+        mutable_bytes_span _storage;
+        std::size_t _used;          // Number of bytes used at the start of the storage.
+    };
+
+
+    namespace detail {
+
+        // serialise_buffer which can be initialised to an object's exact size and then serialised into through a
+        // span_buffer. Deduplicating and parallelising buffers can't, since their behaviour isn't visible through a
+        // span_buffer (and deduplication makes the size unpredictable anyway).
+        template<typename B>
+        concept presizable_buffer = serialise_buffer<B> && !deduplicating_buffer<B> && !parallelising_buffer<B>;
+
+    }
+
+
+    // Initialises the buffer and serialises an entire object beginning from the start of the buffer, like
+    // serialise(source, buffer). However, the buffer is initialised to exactly serialised_size(source) bytes up front,
+    // and is never extended during serialisation, so at most one reallocation occurs.
+    // buffer must not be a dedup_buffer or parallel serialisation buffer.
+    template<size_precomputable T>
+    constexpr void serialise_presized(serialise_source<T> const& source, detail::presizable_buffer auto& buffer) {
+        auto const size = serialised_size(source);
+        span_buffer presized_buffer{buffer.initialise(size)};
+        serialise(source, presized_buffer);
+        assert(presized_buffer.span().size() == size);
+    }
+
+
+    // Location of one object within a buffer written by serialise_batch().
+    // Format determines the integer type of the offset and size (see format_profile).
+    template<format_profile Format = compact_format>
+    struct basic_batch_entry {
+        Format::offset_type offset;     // Index in the buffer at which the object's fixed data begins.
+        Format::size_type size;         // Number of bytes occupied by the object, including its variable data.
+    };
+
+    using batch_entry = basic_batch_entry<compact_format>;
+
+    // batch_entry for batches larger than 4 GiB.
+    using large_batch_entry = basic_batch_entry<large_format>;
+
+
+    namespace detail {
+
+        template<serialisable T, format_profile Format>
+        constexpr void serialise_batch_into(auto&& sources, serialise_buffer auto& buffer,
+                std::vector<basic_batch_entry<Format>>& index) {
+            using offset_type = Format::offset_type;
+            for (auto&& source : sources) {
+                auto const fixed_offset = buffer.span().size();
+                buffer.extend(fixed_data_size_v<T>);
+                serialise(as_serialise_source<T>(source), buffer, fixed_offset);
+                auto const size = buffer.span().size() - fixed_offset;
+                index.push_back({
+                    to_data_offset<offset_type>(fixed_offset), to_size_type<Format>(size, "batch object size")});
+            }
+        }
+
+    }
+
+
+    // Initialises the buffer and serialises many independent objects contiguously, one after another.
+    // Returns an index with the location of each object, in the order of sources. Object i can be deserialised with
+    // deserialise<T>(buffer.span(), index[i].offset).
+    // If T is size_precomputable, sources can be iterated multiple times, and buffer doesn't deduplicate or serialise
+    // in parallel, the buffer is initialised to exactly the total size up front and never extended, so at most one
+    // reallocation occurs.
+    // Format determines the integer type of the index entries. It should be large_format if the objects are (i.e. if
+    // the batch may be larger than 4 GiB).
+    template<serialisable T, format_profile Format = compact_format, std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, serialise_source<T> const&>
+    constexpr std::vector<basic_batch_entry<Format>> serialise_batch(R&& sources, serialise_buffer auto& buffer) {
+        std::vector<basic_batch_entry<Format>> index;
+        if constexpr (std::ranges::sized_range<R>) {
+            index.reserve(std::ranges::size(sources));
+        }
+        if constexpr (size_precomputable<T> && std::ranges::forward_range<R>
+                && detail::presizable_buffer<std::remove_cvref_t<decltype(buffer)>>) {
+            std::size_t size = 0;
+            for (auto&& source : sources) {
+                size += serialised_size(detail::as_serialise_source<T>(source));
+            }
+            span_buffer presized_buffer{buffer.initialise(size)};
+            detail::serialise_batch_into<T, Format>(sources, presized_buffer, index);
+            assert(presized_buffer.span().size() == size);
+        }
+        else {
+            buffer.initialise(0);
+            detail::serialise_batch_into<T, Format>(sources, buffer, index);
+        }
+        return index;
+    }
+
+
     namespace detail {
 
+        // serialise_buffer implementation that serialises into one region of a larger buffer, so that disjoint regions
+        // can be serialised concurrently.
+        // span() covers the larger buffer from its start up to the used part of the region, so that data offsets
+        // remain relative to the start of the larger buffer. If the region is too small, std::bad_alloc is thrown.
+        class region_buffer {
+        public:
+            // The region is [begin, end) of storage.
+            constexpr region_buffer(mutable_bytes_span const storage, std::size_t const begin, std::size_t const end)
+                    noexcept :
+                _storage{storage},
+                _begin{begin},
+                _end{end},
+                _used{begin}
+            {
+                assert(begin <= end && end <= storage.size());
+            }
+
+            // Sets the used size of the region, ready for a new serialisation.
+            constexpr mutable_bytes_span initialise(std::size_t const size) {
+                if (_end - _begin < size) {
+                    throw std::bad_alloc{};
+                }
+                _used = _begin + size;
+                return span();
+            }
+
+            constexpr mutable_bytes_span extend(std::size_t const count) {
+                if (_end - _used < count) {
+                    throw std::bad_alloc{};
+                }
+                _used += count;
+                return span();
+            }
+
+            [[nodiscard]]
+            constexpr mutable_bytes_span span() noexcept {
+                return _storage.first(_used);
+            }
+
+        private:
+            mutable_bytes_span _storage;
+            std::size_t _begin;
+            std::size_t _end;
+            std::size_t _used;          // Index in storage of the end of the used part of the region.
+        };
+
+
         // A runtime polymorphic interface for serialise_buffer, which is useful in some scenarios.
         class virtual_buffer {
         public:
@@ -114,6 +526,35 @@ namespace serialpp {
 
             [[nodiscard]]
             virtual constexpr mutable_bytes_span span() noexcept = 0;
+
+            // Checks if the underlying buffer is a deduplicating_buffer.
+            [[nodiscard]]
+            constexpr bool deduplicates() const noexcept {
+                return _deduplicates;
+            }
+
+            // Only called if deduplicates() returns true.
+            virtual constexpr std::size_t deduplicate(std::size_t offset) = 0;
+
+            // Gets the parallel executor requested by the underlying buffer (see parallelising_buffer), or null.
+            [[nodiscard]]
+            constexpr parallel_executor const* parallel() const noexcept {
+                return _parallel;
+            }
+
+        protected:
+            constexpr virtual_buffer(bool const deduplicates, parallel_executor const* const parallel) noexcept :
+                _deduplicates{deduplicates},
+                _parallel{parallel}
+            {}
+
+            ~virtual_buffer() = default;
+
+        private:
+            // These are properties of the underlying buffer which don't change, so they are stored as plain values
+            // rather than being queried through virtual calls.
+            bool _deduplicates;
+            parallel_executor const* _parallel;
         };
 
 
@@ -122,6 +563,7 @@ namespace serialpp {
         class virtual_buffer_impl final : public virtual_buffer {
         public:
             constexpr virtual_buffer_impl(Buffer& buffer) noexcept :
+                virtual_buffer{deduplicating_buffer<Buffer>, buffer_parallel_executor(buffer)},
                 _buffer{buffer}
             {}
 
@@ -138,6 +580,15 @@ namespace serialpp {
                 return _buffer.span();
             }
 
+            constexpr std::size_t deduplicate(std::size_t const offset) final {
+                if constexpr (deduplicating_buffer<Buffer>) {
+                    return _buffer.deduplicate(offset);
+                }
+                else {
+                    return offset;
+                }
+            }
+
         private:
             Buffer& _buffer;
         };
@@ -164,12 +615,27 @@ namespace serialpp {
                 return _span;
             }
 
+            constexpr std::size_t deduplicate(std::size_t const offset) {
+                // Most buffers don't deduplicate, in which case the virtual call can be skipped.
+                if (!_base.deduplicates()) {
+                    return offset;
+                }
+                auto const result = _base.deduplicate(offset);
+                _span = _base.span();
+                return result;
+            }
+
+            [[nodiscard]]
+            constexpr parallel_executor const* parallel() const noexcept {
+                return _base.parallel();
+            }
+
         private:
             virtual_buffer& _base;
 
             // Accessing the buffer's data span is common, so we can avoid virtual calls and gain performance by storing
             // it here.
-            // Must ensure that this is updated every time initialise() or extend() is called.
+            // Must ensure that this is updated every time initialise(), extend() or deduplicate() is called.
             mutable_bytes_span _span;
         };
 
@@ -10,6 +10,7 @@
 #include <limits>
 #include <span>
 #include <stdexcept>
+#include <string_view>
 #include <typeinfo>
 #include <type_traits>
 #include <utility>
@@ -29,6 +30,28 @@ namespace serialpp {
     using data_offset_t = std::uint32_t;
 
 
+    // Determines the integer types in the fixed data of types which refer to variable data (dynamic_array, optional,
+    // variant). It requires:
+    //   - offset_type: unsigned integer type of offsets to variable data. Limits the size of the whole buffer.
+    //   - size_type: unsigned integer type of element counts.
+    template<typename F>
+    concept format_profile = std::unsigned_integral<typename F::offset_type>
+        && std::unsigned_integral<typename F::size_type>;
+
+    // The default format profile. Buffers are limited to 4 GiB.
+    struct compact_format {
+        using offset_type = data_offset_t;
+        using size_type = std::uint32_t;
+    };
+
+    // Format profile for buffers larger than 4 GiB, at the cost of 8 extra bytes of fixed data per dynamic_array and 4
+    // per optional or variant.
+    struct large_format {
+        using offset_type = std::uint64_t;
+        using size_type = std::uint64_t;
+    };
+
+
     // A container of bytes which data can be serialised into.
     // It requires:
     //   - initialise(size) member function which initialises the buffer for a new serialisation. size is the number of
@@ -47,6 +70,72 @@ namespace serialpp {
     };
 
 
+    // A serialise_buffer which can also be shrunk. It requires:
+    //   - truncate(size) member function which reduces the size of the current buffer to size bytes, keeping the
+    //       content before size. Returns the new value of span().
+    template<typename T>
+    concept truncatable_buffer = serialise_buffer<T> && requires(T& t, std::size_t const size) {
+        { t.truncate(size) } -> std::same_as<mutable_bytes_span>;
+    };
+
+
+    // Runs work on multiple threads, for parallel serialisation and validation.
+    // Implemented in parallel.hpp (see parallel_options), so that only code which uses parallelism depends on threads.
+    class parallel_executor {
+    public:
+        // Gets the number of slices to split element_count elements into, each processed by a separate thread.
+        [[nodiscard]]
+        virtual std::size_t slice_count(std::size_t element_count) const noexcept = 0;
+
+        // Invokes func(i) for each i in [0, count), each on a separate thread.
+        // Returns once all invocations have completed. If any invocation throws, one of the exceptions is rethrown.
+        virtual void invoke(std::size_t count, std::function<void(std::size_t)> const& func) const = 0;
+
+        // Invokes func(begin, end) for consecutive chunks [begin, end) of [0, count), on slice_count(count) threads.
+        // Threads claim chunks dynamically, so work is balanced even if some elements take longer than others.
+        // Returns once all invocations have completed. If any invocation throws, one of the exceptions is rethrown.
+        virtual void for_chunks(std::size_t count, std::function<void(std::size_t, std::size_t)> const& func) const
+            = 0;
+
+    protected:
+        // Implementations are never destroyed through this interface.
+        ~parallel_executor() = default;
+    };
+
+
+    namespace detail {
+
+        // serialise_buffer which deduplicates variable data (see dedup_buffer).
+        // deduplicate(offset) is called when the variable data from offset to the end of the buffer is complete. If it
+        // is identical to data serialised earlier, the buffer is truncated to offset and the offset of the earlier data
+        // is returned. Otherwise, offset is returned.
+        template<typename T>
+        concept deduplicating_buffer = serialise_buffer<T> && requires(T& t, std::size_t const offset) {
+            { t.deduplicate(offset) } -> std::same_as<std::size_t>;
+        };
+
+        // serialise_buffer which requests parallel serialisation (see serialise(parallel_options, source, buffer)).
+        // parallel() returns the executor with which large dynamic_arrays are serialised on multiple threads.
+        template<typename T>
+        concept parallelising_buffer = serialise_buffer<T> && requires(T const& t) {
+            { t.parallel() } noexcept -> std::same_as<parallel_executor const*>;
+        };
+
+        // Gets the parallel executor requested by buffer, or null if it should be serialised into sequentially.
+        template<typename B>
+        [[nodiscard]]
+        constexpr parallel_executor const* buffer_parallel_executor(B const& buffer) noexcept {
+            if constexpr (parallelising_buffer<B>) {
+                return buffer.parallel();
+            }
+            else {
+                return nullptr;
+            }
+        }
+
+    }
+
+
     // The size in bytes of the fixed data section of a serialisable type (as an std::integral_constant).
     template<typename T>
     struct fixed_data_size;
@@ -77,6 +166,11 @@ namespace serialpp {
         // An optional overload for types which don't use variable data.
         static void serialise(serialise_source<T> const& source, mutable_bytes_span buffer, std::size_t fixed_offset)
                 = delete;
+
+        // An optional function for types which may use variable data.
+        // Computes the exact number of bytes of variable data that serialise() will append to the buffer for source.
+        // Enables serialised_size() and serialise_presized().
+        static std::size_t variable_data_size(serialise_source<T> const& source) = delete;
     };
 
 
@@ -89,6 +183,15 @@ namespace serialpp {
         // The deserialiser need not check if fixed_offset is valid, i.e. the caller must ensure:
         //   (fixed_offset + fixed_data_size_v<T>) <= buffer.size()
         deserialiser(const_bytes_span buffer, std::size_t fixed_offset) = delete;
+
+        // An optional member function for types which have subobjects or may use variable data.
+        // Checks that every subobject can be deserialised without out-of-bounds buffer access or invalid values, i.e.
+        // validates every offset, count, etc., recursively. Throws deserialise_error if not.
+        // May assume the fixed data of this object is within the buffer.
+        // If parallel is not null, the validation may be split over multiple threads. It should be passed on to
+        // subobjects (via detail::validate_subobjects()), except those which are already being validated in parallel.
+        // Enables validate().
+        void validate_subobjects(parallel_executor const* parallel = nullptr) const = delete;
     };
 
 
@@ -140,6 +243,25 @@ namespace serialpp {
     template<typename T>
     concept variable_size_serialisable = serialisable<T> && !fixed_size_serialisable<T>;
 
+    // Serialisable type whose exact serialised size can be computed from a serialise_source before serialising.
+    // Always true for fixed_size_serialisable types. Otherwise, serialiser<T> must provide variable_data_size().
+    template<typename T>
+    concept size_precomputable =
+        fixed_size_serialisable<T>
+        || (serialisable<T> && requires(serialise_source<T> const source) {
+            { serialiser<T>::variable_data_size(source) } -> std::same_as<std::size_t>;
+        });
+
+
+    // Serialisable type whose entire object graph can be checked up-front with validate().
+    // Always true for fixed_size_serialisable types. Otherwise, deserialiser<T> must provide validate_subobjects().
+    template<typename T>
+    concept validatable =
+        fixed_size_serialisable<T>
+        || (serialisable<T> && requires(deserialiser<T> const deser) {
+            deser.validate_subobjects();
+        });
+
 
     // A buffer with which serialiser<T> can be invoked.
     // Either a type which satisfies serialise_buffer, or if T satisfies fixed_size_serialisable, mutable_bytes_span.
@@ -220,14 +342,32 @@ namespace serialpp {
     };
 
 
+    // Thrown when a buffer contains a value which is invalid for its type, e.g. an out-of-range variant type index.
+    class invalid_value_error : public deserialise_error {
+    public:
+        invalid_value_error(std::string message) noexcept :
+            _message{std::move(message)}
+        {}
+
+        [[nodiscard]]
+        char const* what() const noexcept override {
+            return _message.c_str();
+        }
+
+    private:
+        std::string _message;
+    };
+
+
     namespace detail {
 
-        // Safely casts to data_offset_t. Throws object_size_error if the value is too big to be stored in a
-        // data_offset_t.
+        // Safely casts to an offset type (data_offset_t by default). Throws object_size_error if the value is too big
+        // to be stored in an Offset.
+        template<std::unsigned_integral Offset = data_offset_t>
         [[nodiscard]]
-        constexpr data_offset_t to_data_offset(std::size_t const offset) {
-            if (std::cmp_less_equal(offset, std::numeric_limits<data_offset_t>::max())) {
-                return static_cast<data_offset_t>(offset);
+        constexpr Offset to_data_offset(std::size_t const offset) {
+            if (std::cmp_less_equal(offset, std::numeric_limits<Offset>::max())) {
+                return static_cast<Offset>(offset);
             }
             else {
                 throw object_size_error{std::format("Data offset {} is too big to be represented", offset)};
@@ -235,6 +375,20 @@ namespace serialpp {
         }
 
 
+        // Safely casts a size or count to Format::size_type. Throws object_size_error if the value is too big to be
+        // stored in a Format::size_type. description names the value in the error message, e.g. "string length".
+        template<format_profile Format = compact_format>
+        [[nodiscard]]
+        constexpr Format::size_type to_size_type(std::size_t const size, std::string_view const description) {
+            if (std::cmp_less_equal(size, std::numeric_limits<typename Format::size_type>::max())) {
+                return static_cast<typename Format::size_type>(size);
+            }
+            else {
+                throw object_size_error{std::format("{} {} is too big to be represented", description, size)};
+            }
+        }
+
+
         // Throws buffer_bounds_error if buffer is too small to contain an instance of T starting at the specified
         // offset.
         template<serialisable T>
@@ -247,6 +401,26 @@ namespace serialpp {
             }
         }
 
+
+        // Throws buffer_bounds_error if buffer is too small to contain count consecutive instances of T starting at the
+        // specified offset.
+        template<serialisable T>
+        constexpr void check_buffer_size_for_elements(const_bytes_span const buffer, std::size_t const offset,
+                std::size_t const count) {
+            bool fits = offset <= buffer.size();
+            if constexpr (fixed_data_size_v<T> > 0) {
+                // Divide instead of multiplying count to avoid overflow.
+                fits = fits && (buffer.size() - offset) / fixed_data_size_v<T> >= count;
+            }
+            if (!fits) {
+                throw buffer_bounds_error{
+                    std::format(
+                        "Data buffer of size {} is too small to deserialise {} elements of type {} with fixed size {} "
+                        "at offset {}",
+                        buffer.size(), count, typeid(T).name(), fixed_data_size_v<T>, offset)};
+            }
+        }
+
     }
 
 
@@ -291,31 +465,65 @@ namespace serialpp {
     // this function to do so, so that the subobjects' fixed data is allocated together (e.g. for dynamic_array).
     // Otherwise, if the subobjects allocate variable data, it will go inbetween the fixed data, and you won't know
     // where each subobject starts.
+    // Returns the offset at which the subobjects' fixed data begins, which should be used to refer to the subobjects.
+    // This is usually the offset func was invoked with, but if the buffer deduplicates variable data (see
+    // dedup_buffer), it may be the offset of an identical copy serialised earlier, and the new copy is removed. Hence
+    // buffer.span().size() read before the call is not a valid offset to the subobjects.
     template<serialisable T, std::invocable<std::size_t const&> F>
-    constexpr void push_variable_subobjects(std::size_t const count, serialise_buffer auto& buffer, F&& func) {
+    [[nodiscard]]
+    constexpr std::size_t push_variable_subobjects(std::size_t const count, serialise_buffer auto& buffer, F&& func) {
         // Assume the buffer doesn't have unused space at the end.
         auto const subobject_fixed_offset = buffer.span().size();
         buffer.extend(fixed_data_size_v<T> * count);
 
         std::invoke(std::forward<F>(func), subobject_fixed_offset);
+
+        if constexpr (detail::deduplicating_buffer<std::remove_reference_t<decltype(buffer)>>) {
+            return buffer.deduplicate(subobject_fixed_offset);
+        }
+        else {
+            return subobject_fixed_offset;
+        }
     }
 
 
+    // Tag for constructing a deserialiser which skips buffer bounds checking for its subobjects.
+    // Only use with buffers which have been checked by validate()!
+    struct unchecked_t {
+        explicit unchecked_t() = default;
+    };
+
+    inline constexpr unchecked_t unchecked{};
+
+
     // Helper for implementing deserialiser.
     class deserialiser_base {
     public:
         constexpr deserialiser_base(const_bytes_span const buffer, std::size_t const fixed_offset) :
-            _buffer{buffer}, _fixed_offset{fixed_offset}
+            _buffer{buffer}, _fixed_offset{fixed_offset}, _checked{true}
+        {}
+
+        constexpr deserialiser_base(const_bytes_span const buffer, std::size_t const fixed_offset, unchecked_t) :
+            _buffer{buffer}, _fixed_offset{fixed_offset}, _checked{false}
         {}
 
     protected:
         const_bytes_span _buffer;
         std::size_t _fixed_offset;
+        // If false, the buffer has already been validated, so subobjects are deserialised without bounds checking.
+        bool _checked;
 
         // Obtains a const_bytes_span of this object's fixed data.
         constexpr const_bytes_span _fixed_data() const {
             return _buffer.subspan(_fixed_offset);
         }
+
+        // Deserialises a subobject of type T from this object's buffer.
+        // Buffer bounds checking is performed, unless this deserialiser was constructed with unchecked, in which case
+        // the subobject's deserialiser is also unchecked.
+        template<serialisable T>
+        [[nodiscard]]
+        constexpr deserialise_t<T> _deserialise(std::size_t fixed_offset) const;
     };
 
 
@@ -364,6 +572,21 @@ namespace serialpp {
             };
         }
 
+
+        // Gets value (which must be convertible to serialise_source<T>) as a serialise_source<T>. Only converts it if
+        // it isn't already one, so ranges of convertible values can be iterated without copying each element.
+        template<serialisable T, typename U>
+        [[nodiscard]]
+        constexpr decltype(auto) as_serialise_source(U&& value) {
+            if constexpr (std::same_as<std::remove_cvref_t<U>, serialise_source<T>>) {
+                return std::forward<U>(value);
+            }
+            else {
+                serialise_source<T> converted = std::forward<U>(value);
+                return converted;
+            }
+        }
+
     }
 
 
@@ -375,6 +598,27 @@ namespace serialpp {
     }
 
 
+    // Computes the exact number of bytes of variable data used when serialising source.
+    template<size_precomputable T>
+    [[nodiscard]]
+    constexpr std::size_t variable_data_size(serialise_source<T> const& source) {
+        if constexpr (fixed_size_serialisable<T>) {
+            return 0;
+        }
+        else {
+            return serialiser<T>::variable_data_size(source);
+        }
+    }
+
+
+    // Computes the exact number of bytes used when serialising an entire object with serialise(source, buffer).
+    template<size_precomputable T>
+    [[nodiscard]]
+    constexpr std::size_t serialised_size(serialise_source<T> const& source) {
+        return fixed_data_size_v<T> + variable_data_size(source);
+    }
+
+
     // Deserialises a type from a buffer.
     // buffer is the full bytes buffer.
     // fixed_offset is the index in buffer at which this value's fixed data begins.
@@ -387,4 +631,78 @@ namespace serialpp {
         return auto_deserialise(deser);
     }
 
+
+    template<serialisable T>
+    constexpr deserialise_t<T> deserialiser_base::_deserialise(std::size_t const fixed_offset) const {
+        if constexpr (std::constructible_from<deserialiser<T>, const_bytes_span const&, std::size_t const&,
+                unchecked_t const&>) {
+            if (!_checked) {
+                assert(fixed_offset <= _buffer.size() && _buffer.size() - fixed_offset >= fixed_data_size_v<T>);
+                deserialiser<T> const deser{_buffer, fixed_offset, unchecked};
+                return auto_deserialise(deser);
+            }
+        }
+        return deserialise<T>(_buffer, fixed_offset);
+    }
+
+
+    namespace detail {
+
+        // Throws deserialise_error if any subobject of the T at fixed_offset can't be deserialised.
+        // The fixed data of the T itself must already have been bounds checked.
+        // If parallel is not null, the validation may be split over multiple threads.
+        template<validatable T>
+        constexpr void validate_subobjects(const_bytes_span const buffer, std::size_t const fixed_offset,
+                parallel_executor const* const parallel = nullptr) {
+            // Fixed size types only ever access their own fixed data, so there's nothing more to check.
+            if constexpr (!fixed_size_serialisable<T>) {
+                deserialiser<T> const deser{buffer, fixed_offset};
+                if constexpr (requires { deser.validate_subobjects(parallel); }) {
+                    deser.validate_subobjects(parallel);
+                }
+                else {
+                    deser.validate_subobjects();
+                }
+            }
+        }
+
+        // Throws deserialise_error if the T at fixed_offset, or any of its subobjects, can't be deserialised.
+        template<validatable T>
+        constexpr void validate_object(const_bytes_span const buffer, std::size_t const fixed_offset,
+                parallel_executor const* const parallel = nullptr) {
+            check_buffer_size_for<T>(buffer, fixed_offset);
+            validate_subobjects<T>(buffer, fixed_offset, parallel);
+        }
+
+        template<validatable T>
+        [[nodiscard]]
+        constexpr deserialise_t<T> unchecked_deserialise(const_bytes_span const buffer,
+                std::size_t const fixed_offset) {
+            if constexpr (std::constructible_from<deserialiser<T>, const_bytes_span const&, std::size_t const&,
+                    unchecked_t const&>) {
+                deserialiser<T> const deser{buffer, fixed_offset, unchecked};
+                return auto_deserialise(deser);
+            }
+            else {
+                deserialiser<T> const deser{buffer, fixed_offset};
+                return auto_deserialise(deser);
+            }
+        }
+
+    }
+
+
+    // Checks an entire object in a buffer up-front, then deserialises it without any further buffer bounds checking.
+    // buffer is the full bytes buffer.
+    // fixed_offset is the index in buffer at which this value's fixed data begins.
+    // Every offset, count, etc. reachable from the object is checked once here. Throws deserialise_error if any is
+    // invalid. The returned deserialiser, and any deserialisers obtained from it, skip all per-access bounds checks.
+    // Useful when an object is accessed many times, e.g. scanning large arrays.
+    template<validatable T>
+    [[nodiscard]]
+    constexpr deserialise_t<T> validate(const_bytes_span const buffer, std::size_t const fixed_offset = 0) {
+        detail::validate_object<T>(buffer, fixed_offset);
+        return detail::unchecked_deserialise<T>(buffer, fixed_offset);
+    }
+
 }
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "buffers.hpp"
+#include "common.hpp"
+
+
+namespace serialpp {
+
+    // serialise_buffer which wraps another buffer and deduplicates variable data while serialising.
+    // Whenever a block of variable data (the elements of a dynamic_array, or the value of an optional or variant) is
+    // byte-for-byte identical to a block serialised earlier, the new block is removed and the earlier block is referred
+    // to instead. The result is deserialised as normal; several offsets just refer to the same data.
+    // Blocks are compared including the offsets within them, so a block which contains variable data of its own (e.g.
+    // a record with a dynamic_array field) only matches once that variable data has been deduplicated too, i.e. from
+    // its third occurrence.
+    // Serialising with this buffer is slower, since every block is hashed. Parallel serialisation of dynamic_array
+    // elements doesn't deduplicate within the elements.
+    template<truncatable_buffer B>
+    class dedup_buffer {
+    public:
+        // buffer is the buffer to serialise into. It must outlive this object.
+        // Blocks smaller than min_block_size bytes are not deduplicated, since the lookup isn't worth it.
+        explicit dedup_buffer(B& buffer, std::size_t const min_block_size = 1) noexcept :
+            _buffer{buffer},
+            _min_block_size{std::max<std::size_t>(min_block_size, 1)}
+        {}
+
+        dedup_buffer(dedup_buffer const&) = delete;
+        dedup_buffer& operator=(dedup_buffer const&) = delete;
+
+        // Sets the size in bytes of the buffer, ready for a new serialisation. Blocks from previous serialisations are
+        // forgotten.
+        // Same semantics as B::initialise().
+        mutable_bytes_span initialise(std::size_t const size) {
+            _blocks.clear();
+            _history.clear();
+            return _buffer.initialise(size);
+        }
+
+        // Extends the buffer by count bytes, while maintaining the previous content.
+        // Same semantics as B::extend().
+        mutable_bytes_span extend(std::size_t const count) {
+            return _buffer.extend(count);
+        }
+
+        [[nodiscard]]
+        mutable_bytes_span span() noexcept {
+            return _buffer.span();
+        }
+
+        // Called by serialisers when the block of variable data from offset to the end of the buffer is complete.
+        // If the block is identical to an earlier one, the buffer is truncated to offset and the earlier block's offset
+        // is returned. Otherwise, the block is remembered and offset is returned.
+        std::size_t deduplicate(std::size_t const offset) {
+            auto const buffer = _buffer.span();
+            assert(offset <= buffer.size());
+            auto const block = buffer.subspan(offset);
+            if (block.size() < _min_block_size) {
+                return offset;
+            }
+
+            auto const hash = _hash(block);
+            auto const [begin, end] = _blocks.equal_range(hash);
+            for (auto it = begin; it != end; ++it) {
+                auto const other_offset = it->second.offset;
+                // Blocks nested within this one can't be referred to, since they're about to be removed.
+                if (it->second.size == block.size() && other_offset + block.size() <= offset
+                        && std::memcmp(buffer.data() + other_offset, block.data(), block.size()) == 0) {
+                    _forget_from(offset);
+                    _buffer.truncate(offset);
+                    return other_offset;
+                }
+            }
+
+            _blocks.emplace(hash, _block{offset, block.size()});
+            _history.emplace_back(hash, offset);
+            return offset;
+        }
+
+    private:
+        struct _block {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        B& _buffer;
+        std::size_t _min_block_size;
+        // Blocks serialised so far, by hash of their content.
+        std::unordered_multimap<std::size_t, _block> _blocks;
+        // Hash and offset of each block in _blocks, in the order they were added.
+        std::vector<std::pair<std::size_t, std::size_t>> _history;
+
+        [[nodiscard]]
+        static std::size_t _hash(const_bytes_span const block) noexcept {
+            std::string_view const chars{reinterpret_cast<char const*>(block.data()), block.size()};
+            return std::hash<std::string_view>{}(chars);
+        }
+
+        // Forgets all blocks which begin at or after offset.
+        void _forget_from(std::size_t const offset) {
+            // Blocks nested within the block at offset were added after any block before offset, so they're the most
+            // recently added.
+            while (!_history.empty() && _history.back().second >= offset) {
+                auto const [hash, block_offset] = _history.back();
+                auto const [begin, end] = _blocks.equal_range(hash);
+                auto const it = std::find_if(begin, end, [block_offset](auto const& entry) {
+                    return entry.second.offset == block_offset;
+                });
+                assert(it != end);
+                _blocks.erase(it);
+                _history.pop_back();
+            }
+        }
+    };
+
+}
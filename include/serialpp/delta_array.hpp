@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "common.hpp"
+#include "dynamic_array.hpp"
+#include "scalar.hpp"
+#include "utility.hpp"
+
+
+namespace serialpp {
+
+    /*
+        delta_array:
+            Fixed data is an element count (Format::size_type) and an offset (Format::offset_type).
+            If the element count is 0, then the offset is not significant and no variable data is present.
+            If the element count is > 0, then the elements are split into blocks of delta_array_block_size elements
+            (the last block may be smaller), and the variable data starting at the offset is:
+                - A header for each block, consisting of:
+                    - The block's first element (as std::make_unsigned_t<I>).
+                    - The block's minimum delta (std::make_unsigned_t<I>).
+                    - The bit width of the block's packed deltas (std::uint8_t).
+                    - The offset of the block's packed deltas from the end of the headers (Format::offset_type).
+                - The packed deltas of each block.
+            The delta of an element is its difference from the previous element in the block, modulo 2^N (N being the
+            number of bits of I). The minimum delta is the least delta in the block when interpreted as a signed
+            integer. Each delta minus the minimum delta is stored as an unsigned integer of the block's bit width,
+            packed from the least significant bit of each byte upwards. A block's packed deltas occupy whole bytes.
+    */
+
+
+    // Number of elements in each block of a delta_array.
+    inline constexpr std::size_t delta_array_block_size = 128;
+
+
+    namespace detail {
+
+        // Reads a width-bit unsigned integer starting at bit_offset within bits.
+        [[nodiscard]]
+        constexpr std::uint64_t read_packed_bits(const_bytes_span const bits, std::size_t const bit_offset,
+                unsigned const width) noexcept {
+            std::uint64_t value = 0;
+            unsigned read = 0;
+            auto byte = bit_offset / 8;
+            auto shift = static_cast<unsigned>(bit_offset % 8);
+            while (read < width) {
+                value |= (std::to_integer<std::uint64_t>(bits[byte]) >> shift) << read;
+                read += 8 - shift;
+                shift = 0;
+                ++byte;
+            }
+            if (width < 64) {
+                value &= (std::uint64_t{1} << width) - 1;
+            }
+            return value;
+        }
+
+
+        // Writes the low width bits of value starting at bit_offset within bits.
+        // Bits must be written in order from the start of a byte, since later bits in a byte are combined with the
+        // earlier ones rather than overwritten.
+        constexpr void write_packed_bits(mutable_bytes_span const bits, std::size_t bit_offset, std::uint64_t value,
+                unsigned width) noexcept {
+            while (width > 0) {
+                auto const byte = bit_offset / 8;
+                auto const shift = static_cast<unsigned>(bit_offset % 8);
+                auto const count = std::min(8 - shift, width);
+                auto const part = static_cast<std::byte>((value & ((1u << count) - 1)) << shift);
+                if (shift == 0) {
+                    bits[byte] = part;
+                }
+                else {
+                    bits[byte] |= part;
+                }
+                value >>= count;
+                width -= count;
+                bit_offset += count;
+            }
+        }
+
+    }
+
+
+    // Serialisable variable-length array of integers which is compact for sorted or slowly-changing sequences (e.g.
+    // timestamps, sequence numbers, sorted IDs).
+    // Elements are stored in blocks of delta_array_block_size, each with its first element and the differences between
+    // consecutive elements bit-packed with the fewest bits possible. For example, an arithmetic sequence needs 0 bits
+    // per element.
+    // Random access to an element decodes the preceding elements of its block.
+    // Format determines the size of the element count and offsets (see format_profile).
+    template<std::integral I, format_profile Format = compact_format> requires (!std::same_as<I, bool>)
+    struct delta_array {
+        using value_type = I;
+        using format = Format;
+    };
+
+
+    template<std::integral I, format_profile Format>
+    struct fixed_data_size<delta_array<I, Format>> : detail::size_t_constant<
+        fixed_data_size_v<typename Format::size_type> + fixed_data_size_v<typename Format::offset_type>> {};
+
+
+    // Constructible from a braced-init-list of integers, or a std::vector rvalue of integers (which are owned), or a
+    // std::span of integers (which are referenced).
+    template<std::integral I, format_profile Format>
+    class serialise_source<delta_array<I, Format>> : public detail::maybe_owned_span<I> {
+    public:
+        using detail::maybe_owned_span<I>::maybe_owned_span;
+
+        // Gets the elements to be serialised.
+        [[nodiscard]]
+        constexpr std::span<I const> elements() const noexcept {
+            return this->get();
+        }
+    };
+
+
+    template<std::integral I, format_profile Format>
+    struct serialiser<delta_array<I, Format>> {
+        using _unsigned_type = std::make_unsigned_t<I>;
+        using _offset_type = Format::offset_type;
+
+        static constexpr std::size_t _header_size =
+            2 * fixed_data_size_v<_unsigned_type> + fixed_data_size_v<std::uint8_t> + fixed_data_size_v<_offset_type>;
+
+        // Parameters of a block of elements.
+        struct _block {
+            std::span<I const> elements;
+            _unsigned_type min_delta;
+            unsigned width;
+
+            [[nodiscard]]
+            constexpr std::size_t packed_size() const noexcept {
+                // The first element isn't packed.
+                return ((elements.size() - 1) * width + 7) / 8;
+            }
+        };
+
+        static constexpr void serialise(serialise_source<delta_array<I, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            using size_type = Format::size_type;
+
+            auto const elements = source.elements();
+            auto const count = detail::to_dynamic_array_size<Format>(elements.size());
+            _offset_type offset = 0;
+            if (!elements.empty()) {
+                // Measure first so the buffer is only extended once.
+                auto const size = variable_data_size(source);
+                auto const data_offset = push_variable_subobjects<std::byte>(size, buffer,
+                    [&buffer, elements](std::size_t const data_offset) {
+                        _serialise_blocks(elements, buffer.span(), data_offset);
+                    });
+                offset = detail::to_data_offset<_offset_type>(data_offset);
+            }
+
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<size_type>{count}, buffer));
+            fixed_offset = push_fixed_subobject<_offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<_offset_type>{offset}, buffer));
+        }
+
+        static constexpr std::size_t variable_data_size(serialise_source<delta_array<I, Format>> const& source) {
+            auto const elements = source.elements();
+            std::size_t size = 0;
+            for (std::size_t begin = 0; begin < elements.size(); begin += delta_array_block_size) {
+                size += _header_size + _make_block(elements, begin).packed_size();
+            }
+            return size;
+        }
+
+        [[nodiscard]]
+        static constexpr _block _make_block(std::span<I const> const elements, std::size_t const begin) noexcept {
+            auto const count = std::min(delta_array_block_size, elements.size() - begin);
+            auto const block_elements = elements.subspan(begin, count);
+            using signed_type = std::make_signed_t<_unsigned_type>;
+            auto min_delta = count > 1 ? std::numeric_limits<signed_type>::max() : signed_type{0};
+            for (std::size_t i = 1; i < block_elements.size(); ++i) {
+                min_delta = std::min(min_delta, static_cast<signed_type>(_delta(block_elements, i)));
+            }
+            _unsigned_type max_packed = 0;
+            for (std::size_t i = 1; i < block_elements.size(); ++i) {
+                auto const packed = static_cast<_unsigned_type>(_delta(block_elements, i) - min_delta);
+                max_packed = std::max(max_packed, packed);
+            }
+            auto const width = static_cast<unsigned>(std::bit_width(max_packed));
+            return {block_elements, static_cast<_unsigned_type>(min_delta), width};
+        }
+
+        // Difference between element i and element i - 1, modulo 2^N.
+        [[nodiscard]]
+        static constexpr _unsigned_type _delta(std::span<I const> const elements, std::size_t const i) noexcept {
+            return static_cast<_unsigned_type>(
+                static_cast<_unsigned_type>(elements[i]) - static_cast<_unsigned_type>(elements[i - 1]));
+        }
+
+        static constexpr void _serialise_blocks(std::span<I const> const elements, mutable_bytes_span const buffer,
+                std::size_t header_offset) {
+            auto const block_count = (elements.size() + delta_array_block_size - 1) / delta_array_block_size;
+            auto const packed_offset = header_offset + block_count * _header_size;
+            std::size_t block_packed_offset = 0;     // Relative to packed_offset.
+            for (std::size_t begin = 0; begin < elements.size(); begin += delta_array_block_size) {
+                auto const block = _make_block(elements, begin);
+
+                auto const first = static_cast<_unsigned_type>(block.elements[0]);
+                header_offset = push_fixed_subobject<_unsigned_type>(header_offset,
+                    detail::bind_serialise(serialise_source<_unsigned_type>{first}, buffer));
+                header_offset = push_fixed_subobject<_unsigned_type>(header_offset,
+                    detail::bind_serialise(serialise_source<_unsigned_type>{block.min_delta}, buffer));
+                auto const width = static_cast<std::uint8_t>(block.width);
+                header_offset = push_fixed_subobject<std::uint8_t>(header_offset,
+                    detail::bind_serialise(serialise_source<std::uint8_t>{width}, buffer));
+                auto const offset = detail::to_data_offset<_offset_type>(block_packed_offset);
+                header_offset = push_fixed_subobject<_offset_type>(header_offset,
+                    detail::bind_serialise(serialise_source<_offset_type>{offset}, buffer));
+
+                auto const bits = buffer.subspan(packed_offset + block_packed_offset, block.packed_size());
+                for (std::size_t i = 1; i < block.elements.size(); ++i) {
+                    auto const packed = static_cast<_unsigned_type>(_delta(block.elements, i) - block.min_delta);
+                    detail::write_packed_bits(bits, (i - 1) * block.width, packed, block.width);
+                }
+                block_packed_offset += block.packed_size();
+            }
+        }
+    };
+
+
+    template<std::integral I, format_profile Format>
+    class deserialiser<delta_array<I, Format>> : public deserialiser_base {
+    public:
+        using value_type = I;
+
+        using deserialiser_base::deserialiser_base;
+
+        // Gets the number of elements in the delta_array.
+        [[nodiscard]]
+        constexpr std::size_t size() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
+        }
+
+        // Checks if the delta_array contains zero elements.
+        [[nodiscard]]
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        // Gets the element at the specified index. index must be < size().
+        // Decodes the elements preceding index in its block, so is O(delta_array_block_size).
+        [[nodiscard]]
+        constexpr I operator[](std::size_t const index) const {
+            assert(index < size());
+            auto const block = _read_block(_offset(), _block_count(), index / delta_array_block_size);
+            auto value = block.first;
+            for (std::size_t i = 1; i <= index % delta_array_block_size; ++i) {
+                value += _next_delta(block, i);
+            }
+            return static_cast<I>(value);
+        }
+
+        // Gets the element at the specified index. Throws std::out_of_range if index is out of bounds.
+        [[nodiscard]]
+        constexpr I at(std::size_t const index) const {
+            auto const size = this->size();
+            if (index < size) {
+                return (*this)[index];
+            }
+            else {
+                throw std::out_of_range{
+                    std::format("index {} is out of bounds for delta_array with size {}", index, size)};
+            }
+        }
+
+        // Decodes all elements into the beginning of output, converting each to U (which must not narrow), and
+        // returns the part of output which was written.
+        // Throws std::out_of_range if output is smaller than size().
+        template<typename U, std::size_t Extent> requires detail::scalar_convertible_to<I, U>
+        constexpr std::span<U> copy_to(std::span<U, Extent> const output) const {
+            auto const size = this->size();
+            if (output.size() < size) {
+                throw std::out_of_range{
+                    std::format("output of size {} is too small for delta_array with size {}", output.size(), size)};
+            }
+            if (size > 0) {
+                auto const offset = _offset();
+                auto const block_count = _block_count();
+                for (std::size_t block_index = 0; block_index < block_count; ++block_index) {
+                    auto const block = _read_block(offset, block_count, block_index);
+                    auto const block_output = output.subspan(block_index * delta_array_block_size, block.count);
+                    auto value = block.first;
+                    block_output[0] = U(static_cast<I>(value));
+                    for (std::size_t i = 1; i < block.count; ++i) {
+                        value += _next_delta(block, i);
+                        block_output[i] = U(static_cast<I>(value));
+                    }
+                }
+            }
+            return output.first(size);
+        }
+
+        // Decodes all elements into a new std::vector, converting each to U (which must not narrow).
+        template<typename U = I> requires detail::scalar_convertible_to<I, U>
+        [[nodiscard]]
+        constexpr std::vector<U> to_vector() const {
+            std::vector<U> result(size());
+            (void)copy_to(std::span{result});
+            return result;
+        }
+
+        // Checks that every block is within the buffer and has a valid bit width.
+        constexpr void validate_subobjects(parallel_executor const* = nullptr) const {
+            if (size() > 0) {
+                auto const offset = _offset();
+                auto const block_count = _block_count();
+                for (std::size_t block_index = 0; block_index < block_count; ++block_index) {
+                    (void)_read_block(offset, block_count, block_index);
+                }
+            }
+        }
+
+    private:
+        using _unsigned_type = std::make_unsigned_t<I>;
+        using _offset_type = Format::offset_type;
+
+        static constexpr std::size_t _header_size = serialiser<delta_array<I, Format>>::_header_size;
+
+        struct _block {
+            std::size_t count;
+            _unsigned_type first;
+            _unsigned_type min_delta;
+            unsigned width;
+            const_bytes_span bits;
+        };
+
+        [[nodiscard]]
+        constexpr std::size_t _offset() const {
+            auto const offset_offset = _fixed_offset + fixed_data_size_v<typename Format::size_type>;
+            return static_cast<std::size_t>(_deserialise<_offset_type>(offset_offset));
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t _block_count() const {
+            return (size() + delta_array_block_size - 1) / delta_array_block_size;
+        }
+
+        // Reads the header of a block and locates its packed deltas. The packed deltas are always bounds checked,
+        // since decoding relies on them.
+        [[nodiscard]]
+        constexpr _block _read_block(std::size_t const offset, std::size_t const block_count,
+                std::size_t const index) const {
+            auto header_offset = offset + _header_size * index;
+            _block block{};
+            block.count = std::min(delta_array_block_size, size() - delta_array_block_size * index);
+            block.first = _deserialise<_unsigned_type>(header_offset);
+            header_offset += fixed_data_size_v<_unsigned_type>;
+            block.min_delta = _deserialise<_unsigned_type>(header_offset);
+            header_offset += fixed_data_size_v<_unsigned_type>;
+            block.width = _deserialise<std::uint8_t>(header_offset);
+            header_offset += fixed_data_size_v<std::uint8_t>;
+            auto const packed_offset = offset + _header_size * block_count
+                + static_cast<std::size_t>(_deserialise<_offset_type>(header_offset));
+
+            if (block.width > std::numeric_limits<_unsigned_type>::digits) {
+                throw invalid_value_error{
+                    std::format("delta_array block bit width {} is too big for {}-bit integer", block.width,
+                        std::numeric_limits<_unsigned_type>::digits)};
+            }
+            auto const packed_size = ((block.count - 1) * block.width + 7) / 8;
+            if (packed_offset > _buffer.size() || _buffer.size() - packed_offset < packed_size) {
+                throw buffer_bounds_error{
+                    std::format("Data buffer of size {} is too small to deserialise {} bytes of packed deltas at "
+                        "offset {}", _buffer.size(), packed_size, packed_offset)};
+            }
+            block.bits = _buffer.subspan(packed_offset, packed_size);
+            return block;
+        }
+
+        // Gets the delta between element i - 1 and element i of block.
+        [[nodiscard]]
+        static constexpr _unsigned_type _next_delta(_block const& block, std::size_t const i) noexcept {
+            auto const packed = detail::read_packed_bits(block.bits, (i - 1) * block.width, block.width);
+            return static_cast<_unsigned_type>(block.min_delta + static_cast<_unsigned_type>(packed));
+        }
+    };
+
+}
@@ -3,17 +3,23 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <compare>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <format>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <new>
+#include <numeric>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "buffers.hpp"
 #include "common.hpp"
@@ -25,7 +31,8 @@ namespace serialpp {
 
     /*
         dynamic_array:
-            Fixed data is an element count (dynamic_array_size_t) and an offset (data_offset_t).
+            Fixed data is an element count (Format::size_type) and an offset (Format::offset_type).
+            For the default compact_format, these are dynamic_array_size_t and data_offset_t.
             If the element count is > 0, then that many elements are contained starting at the offset.
             If the element count is 0, then the offset is not significant and no variable data is present.
     */
@@ -33,17 +40,24 @@ namespace serialpp {
 
     using dynamic_array_size_t = std::uint32_t;
 
-    inline constexpr std::size_t max_dynamic_array_size = std::numeric_limits<dynamic_array_size_t>::max();
+    // Maximum number of elements of a dynamic_array with the specified format profile.
+    template<format_profile Format>
+    inline constexpr std::size_t basic_max_dynamic_array_size =
+        std::min<std::uintmax_t>(std::numeric_limits<typename Format::size_type>::max(),
+            std::numeric_limits<std::size_t>::max());
+
+    inline constexpr std::size_t max_dynamic_array_size = basic_max_dynamic_array_size<compact_format>;
 
 
     namespace detail {
 
-        // Safely casts to dynamic_array_size_t. Throws object_size_error if the value is too big to be stored in a
-        // dynamic_array_size_t.
+        // Safely casts to Format::size_type. Throws object_size_error if the value is too big to be stored in a
+        // Format::size_type.
+        template<format_profile Format = compact_format>
         [[nodiscard]]
-        constexpr dynamic_array_size_t to_dynamic_array_size(std::size_t const size) {
-            if (std::cmp_less_equal(size, max_dynamic_array_size)) {
-                return static_cast<dynamic_array_size_t>(size);
+        constexpr Format::size_type to_dynamic_array_size(std::size_t const size) {
+            if (std::cmp_less_equal(size, basic_max_dynamic_array_size<Format>)) {
+                return static_cast<typename Format::size_type>(size);
             }
             else {
                 throw object_size_error{
@@ -54,16 +68,23 @@ namespace serialpp {
     }
 
 
-    // Serialisable variable-length homogeneous array. Can hold up to max_dynamic_array_size elements.
-    template<serialisable T>
+    // Serialisable variable-length homogeneous array. Can hold up to basic_max_dynamic_array_size<Format> elements.
+    // Format determines the size of the element count and offset (see format_profile).
+    template<serialisable T, format_profile Format = compact_format>
     struct dynamic_array {
         using element_type = T;
+        using format = Format;
     };
 
-
+    // dynamic_array which can hold more than 2^32 - 1 elements, and refer to variable data anywhere in a buffer larger
+    // than 4 GiB.
     template<serialisable T>
-    struct fixed_data_size<dynamic_array<T>>
-        : detail::size_t_constant<fixed_data_size_v<dynamic_array_size_t> + fixed_data_size_v<data_offset_t>> {};
+    using large_dynamic_array = dynamic_array<T, large_format>;
+
+
+    template<serialisable T, format_profile Format>
+    struct fixed_data_size<dynamic_array<T, Format>> : detail::size_t_constant<
+        fixed_data_size_v<typename Format::size_type> + fixed_data_size_v<typename Format::offset_type>> {};
 
 
     template<typename R, typename T>
@@ -71,8 +92,147 @@ namespace serialpp {
         && std::convertible_to<std::ranges::range_reference_t<R>, serialise_source<T> const&>;
 
 
+    // Number of bytes of storage within serialise_source<dynamic_array<T>> for the range object. Ranges which don't fit
+    // (or which require alignment greater than 8) are dynamically allocated.
+    // Defaults to the size of std::vector. May be specialised to store larger range adaptors (e.g. transform views with
+    // captures) without allocating, at the cost of larger serialise_source objects.
     template<serialisable T>
-    class serialise_source<dynamic_array<T>> {
+    inline constexpr std::size_t dynamic_array_inline_range_size = 24;
+
+
+    namespace detail {
+
+        // Gets the index of the first element in a slice, when element_count elements are split into slice_count
+        // slices as evenly as possible.
+        [[nodiscard]]
+        constexpr std::size_t slice_begin(std::size_t const element_count, std::size_t const slice_count,
+                std::size_t const slice) noexcept {
+            return element_count / slice_count * slice + std::min(slice, element_count % slice_count);
+        }
+
+
+        // Serialises slices of count elements from range on separate threads, as the elements of a dynamic_array<T>.
+        // The variable data of each slice is measured first, so each thread can serialise directly into its own region
+        // of the buffer, in the same layout as sequential serialisation.
+        // Returns the offset of the elements' fixed data.
+        template<serialisable T, std::ranges::random_access_range R, serialise_buffer B>
+        std::size_t serialise_dynamic_array_elements_parallel(R& range, std::size_t const count, B& buffer,
+                parallel_executor const& parallel, std::size_t const slice_count) {
+            auto const elements = std::ranges::begin(range);
+            auto const slice_begin = [count, slice_count](std::size_t const slice) {
+                return detail::slice_begin(count, slice_count, slice);
+            };
+
+            // Offset of each slice's variable data from the start of the elements' variable data.
+            std::vector<std::size_t> variable_offsets(slice_count + 1, 0);
+            if constexpr (!fixed_size_serialisable<T>) {
+                parallel.invoke(slice_count, [&](std::size_t const slice) {
+                    std::size_t size = 0;
+                    for (auto i = slice_begin(slice); i < slice_begin(slice + 1); ++i) {
+                        serialise_source<T> const& element = elements[i];
+                        size += serialpp::variable_data_size<T>(element);
+                    }
+                    variable_offsets[slice + 1] = size;
+                });
+                std::partial_sum(variable_offsets.begin(), variable_offsets.end(), variable_offsets.begin());
+            }
+
+            return push_variable_subobjects<T>(count, buffer, [&](std::size_t const elements_fixed_offset) {
+                auto const variable_begin = buffer.span().size();
+                auto const storage = buffer.extend(variable_offsets.back());
+                parallel.invoke(slice_count, [&](std::size_t const slice) {
+                    region_buffer region{storage, variable_begin + variable_offsets[slice],
+                        variable_begin + variable_offsets[slice + 1]};
+                    for (auto i = slice_begin(slice); i < slice_begin(slice + 1); ++i) {
+                        serialise_source<T> const& element = elements[i];
+                        if constexpr (fixed_size_serialisable<T>) {
+                            serialise(element, storage, elements_fixed_offset + fixed_data_size_v<T> * i);
+                        }
+                        else {
+                            serialise(element, region, elements_fixed_offset + fixed_data_size_v<T> * i);
+                        }
+                    }
+                    assert(region.span().size() == variable_begin + variable_offsets[slice + 1]);
+                });
+            });
+        }
+
+
+        // Serialises count elements from range into the variable data section, as the elements of a
+        // dynamic_array<T>.
+        // If parallel is not null, the elements may be serialised on multiple threads.
+        // Returns the offset of the elements' fixed data.
+        template<serialisable T, typename R, serialise_buffer B>
+        constexpr std::size_t serialise_dynamic_array_elements(R& range, std::size_t const count, B& buffer,
+                parallel_executor const* const parallel) {
+            if constexpr (std::ranges::random_access_range<R> && size_precomputable<T>
+                    && !contiguous_scalar_range<std::remove_cvref_t<R>, T>) {
+                if (parallel && !std::is_constant_evaluated()) {
+                    auto const slice_count = parallel->slice_count(count);
+                    if (slice_count > 1) {
+                        return serialise_dynamic_array_elements_parallel<T>(range, count, buffer, *parallel,
+                            slice_count);
+                    }
+                }
+            }
+
+            auto const serialise_elements = [&buffer, &range](std::size_t const elements_fixed_offset_) {
+                if constexpr (contiguous_scalar_range<std::remove_cvref_t<R>, T>) {
+                    // The elements are already laid out like their serialised representation, so copy in bulk.
+                    serialise_scalars<T>(range, buffer.span(), elements_fixed_offset_);
+                }
+                else {
+                    with_buffer_for<T>(buffer, [elements_fixed_offset_, &range](auto&& buffer) {
+                        // Local copy - mutating a lambda capture seems to inhibit optimisation.
+                        auto elements_fixed_offset = elements_fixed_offset_;
+                        for (auto&& element : range) {
+                            elements_fixed_offset = push_fixed_subobject<T>(elements_fixed_offset,
+                                bind_serialise(as_serialise_source<T>(element), buffer));
+                        }
+                    });
+                }
+            };
+            return push_variable_subobjects<T>(count, buffer, serialise_elements);
+        }
+
+
+        // Computes the number of bytes of variable data used when serialising count elements from range as the
+        // elements of a dynamic_array<T>.
+        template<size_precomputable T, typename R>
+        [[nodiscard]]
+        constexpr std::size_t dynamic_array_elements_size(R& range, std::size_t const count) {
+            auto size = fixed_data_size_v<T> * count;
+            if constexpr (!fixed_size_serialisable<T>) {
+                for (auto&& element : range) {
+                    size += serialpp::variable_data_size<T>(as_serialise_source<T>(element));
+                }
+            }
+            return size;
+        }
+
+
+        // Serialises the fixed data of a dynamic_array with element_count elements, whose elements begin at
+        // elements_offset.
+        template<format_profile Format, typename B>
+        constexpr void serialise_dynamic_array_fixed_data(B& buffer, std::size_t fixed_offset,
+                std::size_t const element_count, std::size_t const elements_offset) {
+            using size_type = Format::size_type;
+            using offset_type = Format::offset_type;
+
+            auto const size = to_dynamic_array_size<Format>(element_count);
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                bind_serialise(serialise_source<size_type>{size}, buffer));
+
+            auto const offset = element_count > 0 ? to_data_offset<offset_type>(elements_offset) : offset_type{0};
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                bind_serialise(serialise_source<offset_type>{offset}, buffer));
+        }
+
+    }
+
+
+    template<serialisable T, format_profile Format>
+    class serialise_source<dynamic_array<T, Format>> {
     public:
         // TODO: move assignable?
 
@@ -82,7 +242,7 @@ namespace serialpp {
         {}
 
         // Constructs from the elements of a braced-init-list.
-        template<std::size_t N> requires (N <= max_dynamic_array_size)
+        template<std::size_t N> requires (N <= basic_max_dynamic_array_size<Format>)
         constexpr serialise_source(serialise_source<T> (&& elements)[N]) :
             _range{}
         {
@@ -91,7 +251,8 @@ namespace serialpp {
                 if (std::is_constant_evaluated()) {
                     // At compile time, always dynamically allocate.
                     [this, &elements] <std::size_t... Is> (std::index_sequence<Is...>) {
-                        _range.set_constexpr_wrapper(new _alloc_range_wrapper<range_type>{std::move(elements[Is])...});
+                        _range.set_constexpr_wrapper(_make_alloc_range_wrapper<range_type>(
+                            std::allocator<range_type>{}, std::move(elements[Is])...));
                     }(std::make_index_sequence<N>{});
                 }
                 else {
@@ -107,28 +268,40 @@ namespace serialpp {
                     else {
                         [this, &elements] <std::size_t... Is> (std::index_sequence<Is...>) {
                             _range.inline_buffer().emplace<_alloc_range_wrapper_base_ptr>(
-                                new _alloc_range_wrapper<range_type>{std::move(elements[Is])...});
+                                _make_alloc_range_wrapper<range_type>(std::allocator<range_type>{},
+                                    std::move(elements[Is])...));
                         }(std::make_index_sequence<N>{});
                     }
                 }
             }
         }
 
-        // Constructs from the elements of a range. The range must have <= max_dynamic_array_size elements.
+        // Constructs from the elements of a range. The range must have <= basic_max_dynamic_array_size<Format>
+        // elements.
         // The range is stored within an instance of std::ranges::views::all.
         template<std::ranges::viewable_range R>
             requires dynamic_array_serialise_source_range<std::ranges::views::all_t<R>, T>
         constexpr serialise_source(R&& range) :
+            serialise_source{std::allocator_arg, std::allocator<std::ranges::views::all_t<R>>{}, std::forward<R>(range)}
+        {}
+
+        // Constructs from the elements of a range, like serialise_source(range), and uses allocator to allocate storage
+        // for the range object if it doesn't fit inline (see dynamic_array_inline_range_size).
+        // The allocator is not used at compile time.
+        template<typename Allocator, std::ranges::viewable_range R>
+            requires dynamic_array_serialise_source_range<std::ranges::views::all_t<R>, T>
+        constexpr serialise_source(std::allocator_arg_t, Allocator const& allocator, R&& range) :
             _range{}
         {
-            assert(std::ranges::size(range) <= max_dynamic_array_size);
+            assert(std::ranges::size(range) <= basic_max_dynamic_array_size<Format>);
 
             using range_type = std::ranges::views::all_t<R>;
             // If we're owning the elements and the range is empty, don't bother storing it.
             if (!std::ranges::empty(range) || std::ranges::borrowed_range<R>) {
                 if (std::is_constant_evaluated()) {
                     // At compile time, always dynamically allocate.
-                    _range.set_constexpr_wrapper(new _alloc_range_wrapper<range_type>{std::forward<R>(range)});
+                    _range.set_constexpr_wrapper(
+                        _make_alloc_range_wrapper<range_type>(std::allocator<range_type>{}, std::forward<R>(range)));
                 }
                 // If the range object is small enough, put it in the inline buffer.
                 else if constexpr (_inline_range_buffer::template can_contain<range_type>()) {
@@ -137,29 +310,31 @@ namespace serialpp {
                 // Otherwise have to dynamically allocate space to type-erase the range.
                 else {
                     _range.inline_buffer().emplace<_alloc_range_wrapper_base_ptr>(
-                        new _alloc_range_wrapper<range_type>{std::forward<R>(range)});
+                        _make_alloc_range_wrapper<range_type>(allocator, std::forward<R>(range)));
                 }
             }
         }
 
     private:
         struct _range_visitor {
-            detail::devirtualised_virtual_buffer& buffer;
+            // If null, the elements are measured instead of serialised.
+            detail::devirtualised_virtual_buffer* buffer = nullptr;
             std::size_t element_count = 0;
+            // Only calculated when serialising.
+            std::size_t elements_offset = 0;
+            // Only calculated when measuring.
+            std::size_t variable_data_size = 0;
 
             constexpr void operator()(dynamic_array_serialise_source_range<T> auto& range) {
                 std::unsigned_integral auto const count = std::ranges::size(range);
                 element_count = count;
-                push_variable_subobjects<T>(count, buffer, [this, &range](std::size_t const elements_fixed_offset_) {
-                    with_buffer_for<T>(buffer, [elements_fixed_offset_, &range](auto&& buffer) {
-                        // Local copy - mutating a lambda capture seems to inhibit optimisation.
-                        auto elements_fixed_offset = elements_fixed_offset_;
-                        for (serialise_source<T> const& element : range) {
-                            elements_fixed_offset = push_fixed_subobject<T>(elements_fixed_offset,
-                                detail::bind_serialise(element, buffer));
-                        }
-                    });
-                });
+                if (buffer) {
+                    elements_offset = detail::serialise_dynamic_array_elements<T>(range, element_count, *buffer,
+                        buffer->parallel());
+                }
+                else if constexpr (size_precomputable<T>) {
+                    variable_data_size = detail::dynamic_array_elements_size<T>(range, element_count);
+                }
             }
         };
 
@@ -168,24 +343,70 @@ namespace serialpp {
             virtual constexpr ~_alloc_range_wrapper_base() = default;
 
             virtual constexpr void visit(_range_visitor& visitor) const = 0;
+
+            // Destroys and deallocates this object, with the allocator it was allocated with.
+            virtual constexpr void destroy() const = 0;
         };
 
-        template<typename R> requires std::is_object_v<R>
+        template<typename R, typename Allocator> requires std::is_object_v<R>
         class _alloc_range_wrapper final : public _alloc_range_wrapper_base {
         public:
+            using allocator_type =
+                typename std::allocator_traits<Allocator>::template rebind_alloc<_alloc_range_wrapper>;
+
             R range;
 
             template<typename... Args>
-            constexpr _alloc_range_wrapper(Args&&... args) :
-                range{std::forward<Args>(args)...}
+            constexpr _alloc_range_wrapper(allocator_type const& allocator, Args&&... args) :
+                range{std::forward<Args>(args)...},
+                _allocator{allocator}
             {}
 
             constexpr void visit(_range_visitor& visitor) const final {
                 visitor(range);
             }
+
+            constexpr void destroy() const final {
+                using traits = std::allocator_traits<allocator_type>;
+                // Allocator must outlive this object.
+                auto allocator = _allocator;
+                // Fine because the object was not created const.
+                auto const self = const_cast<_alloc_range_wrapper*>(this);
+                traits::destroy(allocator, self);
+                traits::deallocate(allocator, self, 1);
+            }
+
+        private:
+            [[no_unique_address]] allocator_type _allocator;
         };
 
-        using _alloc_range_wrapper_base_ptr = detail::constexpr_unique_ptr<_alloc_range_wrapper_base const>;
+        struct _alloc_range_wrapper_deleter {
+            constexpr void operator()(_alloc_range_wrapper_base const* const wrapper) const {
+                wrapper->destroy();
+            }
+        };
+
+        using _alloc_range_wrapper_base_ptr =
+            detail::constexpr_unique_ptr<_alloc_range_wrapper_base const, _alloc_range_wrapper_deleter>;
+
+        // Allocates and constructs an _alloc_range_wrapper holding a range of type R constructed from args.
+        template<typename R, typename Allocator, typename... Args>
+        [[nodiscard]]
+        static constexpr _alloc_range_wrapper_base_ptr _make_alloc_range_wrapper(Allocator const& allocator,
+                Args&&... args) {
+            using wrapper_type = _alloc_range_wrapper<R, Allocator>;
+            using traits = std::allocator_traits<typename wrapper_type::allocator_type>;
+            typename wrapper_type::allocator_type wrapper_allocator{allocator};
+            auto const wrapper = traits::allocate(wrapper_allocator, 1);
+            try {
+                traits::construct(wrapper_allocator, wrapper, wrapper_allocator, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                traits::deallocate(wrapper_allocator, wrapper, 1);
+                throw;
+            }
+            return _alloc_range_wrapper_base_ptr{wrapper};
+        }
 
         struct _range_wrapper_visitor : _range_visitor {
             using _range_visitor::operator();
@@ -198,7 +419,7 @@ namespace serialpp {
 
         static constexpr std::size_t _inline_buffer_size = std::max<std::size_t>(
             sizeof(_alloc_range_wrapper_base_ptr),      // Almost certainly <= 24 bytes.
-            24      // Size of std::vector on GCC, Clang, and MSVC.
+            dynamic_array_inline_range_size<T>
         );
 
         static constexpr std::size_t _inline_buffer_align = std::max<std::size_t>(
@@ -229,8 +450,9 @@ namespace serialpp {
 
                     // Need to do dynamic allocation to prevent constexpr default constructed instance from being used
                     // at runtime (because we wouldn't know which union member is active).
+                    using range_type = std::ranges::empty_view<serialise_source<T>>;
                     std::construct_at(&_constexpr_wrapper,
-                        new _alloc_range_wrapper<std::ranges::empty_view<serialise_source<T>>>{});
+                        _make_alloc_range_wrapper<range_type>(std::allocator<range_type>{}));
                 }
             }
 
@@ -272,9 +494,9 @@ namespace serialpp {
                 return *_constexpr_wrapper;
             }
 
-            constexpr void set_constexpr_wrapper(_alloc_range_wrapper_base const* const ptr) {
+            constexpr void set_constexpr_wrapper(_alloc_range_wrapper_base_ptr wrapper) {
                 assert(std::is_constant_evaluated());
-                _constexpr_wrapper.reset(ptr);
+                _constexpr_wrapper = std::move(wrapper);
             }
 
         private:
@@ -288,18 +510,26 @@ namespace serialpp {
 
         _range_wrapper _range;
 
-        // Returns the number of elements serialised.
+        constexpr void _visit_range(_range_wrapper_visitor& visitor) const {
+            if (std::is_constant_evaluated()) {
+                _range.constexpr_wrapper().visit(visitor);
+            }
+            else {
+                _range.inline_buffer().visit(visitor);
+            }
+        }
+
+        struct _serialised_elements {
+            std::size_t count;
+            std::size_t offset;     // Offset of the elements' fixed data.
+        };
+
         template<serialise_buffer Buffer>
-        constexpr std::size_t _serialise_elements(Buffer& buffer) const {
+        constexpr _serialised_elements _serialise_elements(Buffer& buffer) const {
             auto const visit = [this](detail::devirtualised_virtual_buffer& buffer) {
-                _range_wrapper_visitor range_visitor{buffer};
-                if (std::is_constant_evaluated()) {
-                    _range.constexpr_wrapper().visit(range_visitor);
-                }
-                else {
-                    _range.inline_buffer().visit(range_visitor);
-                }
-                return range_visitor.element_count;
+                _range_wrapper_visitor range_visitor{{.buffer = &buffer}};
+                _visit_range(range_visitor);
+                return _serialised_elements{range_visitor.element_count, range_visitor.elements_offset};
             };
 
             if constexpr (std::same_as<std::remove_cvref_t<Buffer>, detail::devirtualised_virtual_buffer>) {
@@ -312,37 +542,403 @@ namespace serialpp {
             }
         }
 
-        friend struct serialiser<dynamic_array<T>>;
+        // Returns the number of bytes of variable data the elements will use when serialised.
+        constexpr std::size_t _measure_elements() const {
+            _range_wrapper_visitor range_visitor{};
+            _visit_range(range_visitor);
+            return range_visitor.variable_data_size;
+        }
+
+        friend struct serialiser<dynamic_array<T, Format>>;
+    };
+
+    template<serialisable T, format_profile Format>
+    struct serialiser<dynamic_array<T, Format>> {
+        static constexpr void serialise(serialise_source<dynamic_array<T, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            auto const elements = source._serialise_elements(buffer);
+
+            detail::serialise_dynamic_array_fixed_data<Format>(buffer, fixed_offset, elements.count, elements.offset);
+        }
+
+        static constexpr std::size_t variable_data_size(serialise_source<dynamic_array<T, Format>> const& source)
+                requires size_precomputable<T> {
+            return source._measure_elements();
+        }
+    };
+
+
+    // Serialisable type with the same representation as dynamic_array<T, Format> (and deserialised like one), but whose
+    // serialise_source holds a range of type R directly, rather than type-erasing it.
+    // Since the range type is known statically, serialising doesn't need any virtual calls, and can be fully inlined.
+    // This is most significant for small arrays.
+    template<serialisable T, dynamic_array_serialise_source_range<T> R, format_profile Format = compact_format>
+    struct range_dynamic_array {
+        using element_type = T;
+        using range_type = R;
+        using format = Format;
     };
 
-    template<serialisable T>
-    struct serialiser<dynamic_array<T>> {
-        static constexpr void serialise(serialise_source<dynamic_array<T>> const& source, serialise_buffer auto& buffer,
-                std::size_t fixed_offset) {
-            // Must check this first in case elements use variable data.
-            auto const variable_offset = buffer.span().size();
 
-            auto const element_count = source._serialise_elements(buffer);
+    template<serialisable T, typename R, format_profile Format>
+    struct fixed_data_size<range_dynamic_array<T, R, Format>> : fixed_data_size<dynamic_array<T, Format>> {};
 
-            auto const size = detail::to_dynamic_array_size(element_count);
-            fixed_offset = push_fixed_subobject<dynamic_array_size_t>(fixed_offset,
-                detail::bind_serialise(serialise_source<dynamic_array_size_t>{size}, buffer));
 
-            auto const offset = element_count > 0 ? detail::to_data_offset(variable_offset) : data_offset_t{0};
-            fixed_offset = push_fixed_subobject<data_offset_t>(fixed_offset,
-                detail::bind_serialise(serialise_source<data_offset_t>{offset}, buffer));
+    template<serialisable T, typename R, format_profile Format>
+    class serialise_source<range_dynamic_array<T, R, Format>> {
+    public:
+        // The range must have <= basic_max_dynamic_array_size<Format> elements.
+        R range;
+
+        constexpr serialise_source() requires std::default_initializable<R> = default;
+
+        template<typename... Args> requires std::constructible_from<R, Args...>
+        constexpr serialise_source(Args&&... args) :
+            range(std::forward<Args>(args)...)
+        {}
+    };
+
+
+    template<serialisable T, typename R, format_profile Format>
+    struct serialiser<range_dynamic_array<T, R, Format>> {
+        static constexpr void serialise(serialise_source<range_dynamic_array<T, R, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t const fixed_offset) {
+            auto const element_count = static_cast<std::size_t>(std::ranges::size(source.range));
+            assert(element_count <= basic_max_dynamic_array_size<Format>);
+            auto const elements_offset =
+                detail::serialise_dynamic_array_elements<T>(source.range, element_count, buffer,
+                    detail::buffer_parallel_executor(buffer));
+
+            detail::serialise_dynamic_array_fixed_data<Format>(buffer, fixed_offset, element_count, elements_offset);
+        }
+
+        static constexpr std::size_t variable_data_size(
+                serialise_source<range_dynamic_array<T, R, Format>> const& source) requires size_precomputable<T> {
+            return detail::dynamic_array_elements_size<T>(source.range, std::ranges::size(source.range));
         }
     };
 
+
+    // Serialises a dynamic_array by appending elements one at a time as they are produced, rather than requiring all
+    // elements up front in a range.
+    // Elements are serialised directly into the buffer. Since the fixed data of all elements must be contiguous, the
+    // first push_back() adds a block of slots for it (one slot, or as many as set by reserve()), and each element's
+    // fixed data is serialised in place into the next slot, followed by its variable data. If the block is full but
+    // still at the end of the buffer, it is extended. Otherwise (T uses variable data and more elements are appended
+    // than were reserved), all elements' fixed data is instead staged separately and appended by finish(), leaving the
+    // block unused. Likewise, reserved slots which aren't used remain in the buffer, unless they are at its end and B
+    // is a truncatable_buffer. So reserve() the exact element count if it's known.
+    // Nothing else may be serialised into the buffer from the first push_back() until finish().
+    // Format is the format profile of the dynamic_array<T, Format> being built.
+    template<serialisable T, serialise_buffer B, format_profile Format = compact_format>
+    class dynamic_array_builder {
+    public:
+        // Builds the dynamic_array whose fixed data is at fixed_offset within buffer. The fixed data must already be
+        // part of the buffer, e.g. from serialising the dynamic_array's parent object with an empty dynamic_array.
+        constexpr dynamic_array_builder(B& buffer, std::size_t const fixed_offset) noexcept :
+            _buffer{&buffer}, _fixed_offset{fixed_offset}
+        {}
+
+        // Initialises the buffer for a new serialisation with a dynamic_array as the root object, and builds it.
+        explicit constexpr dynamic_array_builder(B& buffer) :
+            _buffer{&buffer}, _fixed_offset{0}
+        {
+            buffer.initialise(fixed_data_size_v<dynamic_array<T, Format>>);
+        }
+
+        dynamic_array_builder(dynamic_array_builder&&) = default;
+        dynamic_array_builder(dynamic_array_builder const&) = delete;
+
+        dynamic_array_builder& operator=(dynamic_array_builder&&) = default;
+        dynamic_array_builder& operator=(dynamic_array_builder const&) = delete;
+
+        // Gets the number of elements appended so far.
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        // Sets the number of elements expected to be appended, so their fixed data can be serialised in place.
+        // Must be called before the first push_back().
+        constexpr void reserve(std::size_t const count) noexcept {
+            assert(_size == 0);
+            _capacity = count;
+        }
+
+        // Serialises an element at the end of the dynamic_array.
+        constexpr void push_back(serialise_source<T> const& element) {
+            assert(!_finished);
+            if (_size == 0) {
+                // Assume the buffer doesn't have unused space at the end.
+                _elements_offset = _buffer->span().size();
+                _capacity = std::max<std::size_t>(_capacity, 1);
+                _buffer->extend(fixed_data_size_v<T> * _capacity);
+            }
+            else if (_size == _capacity && _staged_fixed_data.empty() && _block_at_end()) {
+                // Nothing follows the block, so it can grow in place.
+                _buffer->extend(fixed_data_size_v<T>);
+                ++_capacity;
+            }
+
+            if constexpr (fixed_size_serialisable<T>) {
+                // No variable data is added, so the block is always at the end of the buffer and has room.
+                assert(_size < _capacity);
+                serialise<T>(element, _buffer->span(), _elements_offset + fixed_data_size_v<T> * _size);
+            }
+            else if (_size < _capacity && _staged_fixed_data.empty()) {
+                serialise<T>(element, *_buffer, _elements_offset + fixed_data_size_v<T> * _size);
+            }
+            else {
+                if (_staged_fixed_data.empty()) {
+                    // Move the existing elements' fixed data out of the block, which then only serves as a scratch
+                    // slot for the element being serialised.
+                    auto const block = _buffer->span().subspan(_elements_offset, fixed_data_size_v<T> * _size);
+                    _staged_fixed_data.assign(block.begin(), block.end());
+                }
+                serialise<T>(element, *_buffer, _elements_offset);
+                auto const fixed_data = _buffer->span().subspan(_elements_offset, fixed_data_size_v<T>);
+                _staged_fixed_data.insert(_staged_fixed_data.end(), fixed_data.begin(), fixed_data.end());
+            }
+            ++_size;
+        }
+
+        // Completes the dynamic_array by writing its element count and offset.
+        // Must be called once, after the last element is appended.
+        constexpr void finish() {
+            assert(!_finished);
+            std::size_t offset = 0;
+            if (_size > 0) {
+                if (_staged_fixed_data.empty()) {
+                    offset = _elements_offset;
+                    if constexpr (truncatable_buffer<B>) {
+                        if (_size < _capacity && _block_at_end()) {
+                            // Remove the unused slots.
+                            _buffer->truncate(_elements_offset + fixed_data_size_v<T> * _size);
+                        }
+                    }
+                }
+                else {
+                    offset = _buffer->span().size();
+                    auto const buffer = _buffer->extend(_staged_fixed_data.size());
+                    std::ranges::copy(_staged_fixed_data, buffer.begin() + offset);
+                    _staged_fixed_data.clear();
+                }
+            }
+            auto const buffer = _buffer->span();
+            detail::serialise_dynamic_array_fixed_data<Format>(buffer, _fixed_offset, _size, offset);
+            _finished = true;
+        }
+
+    private:
+        B* _buffer;
+        std::size_t _fixed_offset;      // Offset of the dynamic_array's own fixed data.
+        std::size_t _size = 0;
+        // Number of element slots in the block. Before the first push_back(), the number of slots to add.
+        std::size_t _capacity = 0;
+        std::size_t _elements_offset = 0;       // Offset of the block.
+        // Fixed data of all elements, once they no longer fit in the block. Only used if T isn't fixed size.
+        std::vector<std::byte> _staged_fixed_data;
+        bool _finished = false;
+
+        // Checks if the block is the last part of the buffer.
+        [[nodiscard]]
+        constexpr bool _block_at_end() const noexcept {
+            return _elements_offset + fixed_data_size_v<T> * _capacity == _buffer->span().size();
+        }
+    };
+
+
+    // Random-access view of the elements of a serialised dynamic_array, obtained from
+    // deserialiser<dynamic_array<T, Format>>::elements().
+    // The element count and offset are read once on construction, at which point all elements' fixed data is also
+    // bounds checked. Element access then doesn't need to decode the dynamic_array again.
+    // References only the buffer, so may outlive the deserialiser it was obtained from. Likewise, iterators may outlive
+    // the view.
     template<serialisable T>
-    class deserialiser<dynamic_array<T>> : public deserialiser_base {
+    class dynamic_array_view : public std::ranges::view_interface<dynamic_array_view<T>> {
+    public:
+        class iterator {
+        public:
+            using value_type = deserialise_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            iterator() = default;
+
+            [[nodiscard]]
+            constexpr deserialise_t<T> operator*() const {
+                return dynamic_array_view::_element(_buffer, static_cast<std::size_t>(_offset), _checked);
+            }
+
+            [[nodiscard]]
+            constexpr deserialise_t<T> operator[](difference_type const n) const {
+                return *(*this + n);
+            }
+
+            constexpr iterator& operator++() noexcept {
+                ++_index;
+                _offset += fixed_data_size_v<T>;
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept {
+                auto const old = *this;
+                ++*this;
+                return old;
+            }
+
+            constexpr iterator& operator--() noexcept {
+                --_index;
+                _offset -= fixed_data_size_v<T>;
+                return *this;
+            }
+
+            constexpr iterator operator--(int) noexcept {
+                auto const old = *this;
+                --*this;
+                return old;
+            }
+
+            constexpr iterator& operator+=(difference_type const n) noexcept {
+                _index += n;
+                _offset += n * static_cast<difference_type>(fixed_data_size_v<T>);
+                return *this;
+            }
+
+            constexpr iterator& operator-=(difference_type const n) noexcept {
+                return *this += -n;
+            }
+
+            [[nodiscard]]
+            friend constexpr iterator operator+(iterator it, difference_type const n) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend constexpr iterator operator+(difference_type const n, iterator it) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend constexpr iterator operator-(iterator it, difference_type const n) noexcept {
+                return it -= n;
+            }
+
+            [[nodiscard]]
+            friend constexpr difference_type operator-(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index - rhs._index;
+            }
+
+            [[nodiscard]]
+            friend constexpr bool operator==(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index == rhs._index;
+            }
+
+            [[nodiscard]]
+            friend constexpr std::strong_ordering operator<=>(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index <=> rhs._index;
+            }
+
+        private:
+            friend class dynamic_array_view;
+
+            // The iterator holds what it needs from the view, so it remains valid after the view is destroyed.
+            const_bytes_span _buffer;
+            // Index of the element, only needed for comparisons (since elements may have zero size).
+            difference_type _index = 0;
+            // Offset of the element's fixed data within the buffer.
+            difference_type _offset = 0;
+            bool _checked = true;
+
+            constexpr iterator(dynamic_array_view const& view, difference_type const index) noexcept :
+                _buffer{view._buffer},
+                _index{index},
+                _offset{static_cast<difference_type>(view._offset + fixed_data_size_v<T> * index)},
+                _checked{view._checked}
+            {}
+        };
+
+        dynamic_array_view() = default;
+
+        [[nodiscard]]
+        constexpr iterator begin() const noexcept {
+            return iterator{*this, 0};
+        }
+
+        [[nodiscard]]
+        constexpr iterator end() const noexcept {
+            return iterator{*this, static_cast<std::ptrdiff_t>(_size)};
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        // Gets the element at the specified index. index must be < size().
+        [[nodiscard]]
+        constexpr deserialise_t<T> operator[](std::size_t const index) const {
+            assert(index < _size);
+            return _element(_buffer, _offset + fixed_data_size_v<T> * index, _checked);
+        }
+
+        // Gets the element at the specified index. Throws std::out_of_range if index is out of bounds.
+        [[nodiscard]]
+        constexpr deserialise_t<T> at(std::size_t const index) const {
+            if (index < _size) {
+                return (*this)[index];
+            }
+            else {
+                throw std::out_of_range{
+                    std::format("index {} is out of bounds for dynamic_array with size {}", index, _size)};
+            }
+        }
+
+    private:
+        template<typename>
+        friend class deserialiser;
+
+        const_bytes_span _buffer;
+        std::size_t _offset = 0;
+        std::size_t _size = 0;
+        bool _checked = true;
+
+        // Throws buffer_bounds_error if checked is true and any element's fixed data is out of bounds.
+        constexpr dynamic_array_view(const_bytes_span const buffer, std::size_t const offset, std::size_t const size,
+                bool const checked) :
+            _buffer{buffer}, _offset{offset}, _size{size}, _checked{checked}
+        {
+            if (checked && size > 0) {
+                detail::check_buffer_size_for_elements<T>(buffer, offset, size);
+            }
+        }
+
+        // Deserialises the element at fixed_offset in buffer, whose fixed data has already been bounds checked.
+        [[nodiscard]]
+        static constexpr deserialise_t<T> _element(const_bytes_span const buffer, std::size_t const fixed_offset,
+                bool const checked) {
+            if constexpr (std::constructible_from<deserialiser<T>, const_bytes_span const&, std::size_t const&,
+                    unchecked_t const&>) {
+                if (!checked) {
+                    deserialiser<T> const deser{buffer, fixed_offset, unchecked};
+                    return auto_deserialise(deser);
+                }
+            }
+            deserialiser<T> const deser{buffer, fixed_offset};
+            return auto_deserialise(deser);
+        }
+    };
+
+
+    template<serialisable T, format_profile Format>
+    class deserialiser<dynamic_array<T, Format>> : public deserialiser_base {
     public:
         using deserialiser_base::deserialiser_base;
 
         // Gets the number of elements in the dynamic_array.
         [[nodiscard]]
         constexpr std::size_t size() const {
-            return deserialise<dynamic_array_size_t>(_buffer, _fixed_offset);
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
         }
 
         // Checks if the dynamic_array contains zero elements.
@@ -356,7 +952,7 @@ namespace serialpp {
         constexpr deserialise_t<T> operator[](std::size_t const index) const {
             assert(index < size());
             auto const element_offset = _offset() + fixed_data_size_v<T> * index;
-            return deserialise<T>(_buffer, element_offset);
+            return _deserialise<T>(element_offset);
         }
 
         // Gets the element at the specified index. Throws std::out_of_range if index is out of bounds.
@@ -372,21 +968,127 @@ namespace serialpp {
             }
         }
 
-        // Gets a view of the elements.
-        // The returned view references this deserialiser instance, so cannot outlive it.
+        // Gets a random-access view of the elements.
+        // The element count and offset are read only once, so iterating the view is more efficient than repeatedly
+        // calling operator[]. Throws buffer_bounds_error if any element is out of bounds.
         [[nodiscard]]
-        constexpr std::ranges::random_access_range auto elements() const {
-            return std::ranges::views::iota(std::size_t{0}, size())
-                | std::ranges::views::transform([this](std::size_t const index) {
-                    return (*this)[index];
-                });
+        constexpr dynamic_array_view<T> elements() const {
+            auto const size = this->size();
+            return dynamic_array_view<T>{_buffer, size > 0 ? _offset() : 0, size, _checked};
+        }
+
+        // Gets a contiguous view of the elements which directly references the buffer, avoiding any copying.
+        // This is only possible on little-endian platforms, and if the elements are suitably aligned within the buffer.
+        // Otherwise, returns an empty std::optional.
+        [[nodiscard]]
+        constexpr std::optional<std::span<T const>> elements_span() const requires detail::in_place_scalar<T> {
+            auto const size = this->size();
+            if (size == 0) {
+                return std::span<T const>{};
+            }
+            else {
+                return detail::in_place_scalars<T>(_buffer, _offset(), size);
+            }
+        }
+
+        // Like elements_span(), but if the elements can't be viewed in-place, they are deserialised into
+        // fallback_storage, and a view of fallback_storage is returned instead.
+        [[nodiscard]]
+        constexpr std::span<T const> elements_span(std::vector<T>& fallback_storage) const
+                requires detail::in_place_scalar<T> {
+            if (auto const span = elements_span()) {
+                return *span;
+            }
+            else {
+                fallback_storage.resize(size());
+                detail::deserialise_scalars<T>(_buffer, _offset(), std::span{fallback_storage});
+                return fallback_storage;
+            }
+        }
+
+        // Deserialises all elements into output and returns the part written. Throws std::out_of_range if too small.
+        template<typename U, std::size_t Extent> requires detail::scalar_convertible_to<T, U>
+        constexpr std::span<U> copy_to(std::span<U, Extent> const output) const {
+            auto const size = this->size();
+            if (output.size() < size) {
+                throw std::out_of_range{
+                    std::format("output of size {} is too small for dynamic_array with size {}", output.size(), size)};
+            }
+            auto const written = output.first(size);
+            if (size > 0) {
+                detail::deserialise_scalars<T>(_buffer, _offset(), written);
+            }
+            return written;
+        }
+
+        // Deserialises all elements into a new std::vector, converting each to U (which must not narrow).
+        template<typename U = T> requires detail::scalar_convertible_to<T, U>
+        [[nodiscard]]
+        constexpr std::vector<U> to_vector() const {
+            std::vector<U> result(size());
+            if constexpr (std::same_as<U, bool>) {
+                // std::vector<bool> isn't contiguous.
+                auto const elements = this->elements();
+                std::copy(elements.begin(), elements.end(), result.begin());
+            }
+            else {
+                (void)copy_to(std::span{result});
+            }
+            return result;
+        }
+
+        // Checks that all elements are within the buffer, and validates each element's subobjects.
+        // If parallel is not null and there are many elements, the elements are validated on multiple threads.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires validatable<T> {
+            auto const size = this->size();
+            if (size > 0) {
+                auto const offset = _offset();
+                detail::check_buffer_size_for_elements<T>(_buffer, offset, size);
+                if constexpr (!fixed_size_serialisable<T>) {
+                    auto const validate_elements = [this, offset](std::size_t const begin, std::size_t const end,
+                            parallel_executor const* const element_parallel) {
+                        for (auto i = begin; i < end; ++i) {
+                            detail::validate_subobjects<T>(_buffer, offset + fixed_data_size_v<T> * i,
+                                element_parallel);
+                        }
+                    };
+                    if (parallel && !std::is_constant_evaluated() && parallel->slice_count(size) > 1) {
+                        // Elements are already validated in parallel, so don't parallelise any further.
+                        parallel->for_chunks(size,
+                            [&validate_elements](std::size_t const begin, std::size_t const end) {
+                                validate_elements(begin, end, nullptr);
+                            });
+                    }
+                    else {
+                        validate_elements(0, size, parallel);
+                    }
+                }
+            }
         }
 
     private:
         [[nodiscard]]
-        constexpr data_offset_t _offset() const {
-            return deserialise<data_offset_t>(_buffer, _fixed_offset + fixed_data_size_v<dynamic_array_size_t>);
+        constexpr std::size_t _offset() const {
+            auto const offset_offset = _fixed_offset + fixed_data_size_v<typename Format::size_type>;
+            return static_cast<std::size_t>(_deserialise<typename Format::offset_type>(offset_offset));
         }
     };
 
+
+    template<serialisable T, typename R, format_profile Format>
+    class deserialiser<range_dynamic_array<T, R, Format>> : public deserialiser<dynamic_array<T, Format>> {
+    public:
+        using deserialiser<dynamic_array<T, Format>>::deserialiser;
+    };
+
+}
+
+
+namespace std::ranges {
+
+    // Iterators of dynamic_array_view reference only the buffer, so they may outlive the view.
+    template<::serialpp::serialisable T>
+    inline constexpr bool enable_borrowed_range<::serialpp::dynamic_array_view<T>> = true;
+
 }
@@ -0,0 +1,657 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+#include "dynamic_array.hpp"
+#include "scalar.hpp"
+#include "utility.hpp"
+
+
+namespace serialpp {
+
+    /*
+        hash_map:
+            Fixed data is an entry count (Format::size_type), then a slot count (Format::size_type), then a control
+            bytes offset, a keys offset and a values offset (each Format::offset_type).
+            If the slot count is > 0, it is a power of two >= 8, and:
+              - The control bytes offset refers to (slot count + 7) bytes. The first slot count bytes are the control
+                bytes of each slot: 0x80 if the slot is empty, otherwise the lowest 7 bits of the hash of the slot's
+                key. The last 7 bytes are copies of the first 7 control bytes.
+              - The keys offset refers to the keys' fixed data, one per slot, contiguous like the elements of a
+                dynamic_array. Empty slots contain a default serialise_source<K>.
+              - The values offset refers to the values' fixed data, in the same way as the keys.
+            The entry with key k is stored in the first empty slot (at the time of insertion) found by probing linearly
+            from slot (hash(k) >> 7) % slot count, where hash is the 64-bit stable hash of the key.
+            If the slot count is 0, then the entry count is 0, the offsets are not significant and no variable data is
+            present.
+    */
+
+
+    namespace detail {
+
+        // MurmurHash3's 64-bit finaliser, which mixes all bits of the input into all bits of the output.
+        [[nodiscard]]
+        constexpr std::uint64_t mix_hash(std::uint64_t value) noexcept {
+            value ^= value >> 33;
+            value *= 0xFF51'AFD7'ED55'8CCDull;
+            value ^= value >> 33;
+            value *= 0xC4CE'B9FE'1A85'EC53ull;
+            value ^= value >> 33;
+            return value;
+        }
+
+    }
+
+
+    // Hash function for hash_map keys, which is part of the serialised format (so must never change).
+    // Must be specialised for each K used as a hash_map key, with a constexpr operator() which returns a
+    // std::uint64_t and accepts a serialise_source<K> (used to build the table) and any types which lookups use (at
+    // least deserialise_t<K>). Equivalent keys must have equal hashes.
+    template<serialisable K>
+    struct stable_hash;
+
+
+    // Integers are hashed by numeric value, so keys of differing integer types have equal hashes if their values are
+    // equal.
+    template<serialisable K> requires std::integral<K> || std::same_as<K, std::byte>
+    struct stable_hash<K> {
+        [[nodiscard]]
+        constexpr std::uint64_t operator()(K const key) const noexcept {
+            if constexpr (std::same_as<K, std::byte>) {
+                return detail::mix_hash(std::to_integer<std::uint64_t>(key));
+            }
+            else if constexpr (std::signed_integral<K>) {
+                return detail::mix_hash(static_cast<std::uint64_t>(static_cast<std::int64_t>(key)));
+            }
+            else {
+                return detail::mix_hash(static_cast<std::uint64_t>(key));
+            }
+        }
+    };
+
+
+    namespace detail {
+
+        inline constexpr std::uint8_t hash_map_empty_control = 0x80;
+        // Number of slots whose control bytes are probed at once.
+        inline constexpr std::size_t hash_map_group_size = 8;
+
+        inline constexpr std::uint64_t hash_map_group_low_bits = 0x0101'0101'0101'0101ull;
+        inline constexpr std::uint64_t hash_map_group_high_bits = 0x8080'8080'8080'8080ull;
+
+
+        // Number of slots in a hash_map with count entries, such that at most 7/8 of the slots are full.
+        [[nodiscard]]
+        constexpr std::size_t hash_map_slot_count(std::size_t const count) noexcept {
+            if (count == 0) {
+                return 0;
+            }
+            else {
+                return std::bit_ceil(std::max(count + (count + 6) / 7, hash_map_group_size));
+            }
+        }
+
+
+        // Loads the control bytes of the hash_map_group_size slots starting at slot, with the control byte of
+        // slot + i in byte i of the result (least significant byte first).
+        [[nodiscard]]
+        constexpr std::uint64_t load_hash_map_group(const_bytes_span const control, std::size_t const slot) noexcept {
+            std::uint64_t group = 0;
+            for (std::size_t i = 0; i < hash_map_group_size; ++i) {
+                group |= std::to_integer<std::uint64_t>(control[slot + i]) << (i * 8);
+            }
+            return group;
+        }
+
+
+        // Gets a mask with the high bit set of each byte of group which may equal control. May have false positives,
+        // but never false negatives.
+        [[nodiscard]]
+        constexpr std::uint64_t match_hash_map_group(std::uint64_t const group, std::uint8_t const control) noexcept {
+            auto const difference = group ^ (hash_map_group_low_bits * control);
+            return (difference - hash_map_group_low_bits) & ~difference & hash_map_group_high_bits;
+        }
+
+
+        // Gets a mask with the high bit set of each byte of group which is an empty slot.
+        [[nodiscard]]
+        constexpr std::uint64_t match_hash_map_group_empty(std::uint64_t const group) noexcept {
+            return group & hash_map_group_high_bits;
+        }
+
+
+        // Gets the control byte (the low 7 bits) and first probed slot (the remaining bits) from a key's hash.
+        [[nodiscard]]
+        constexpr std::pair<std::uint8_t, std::size_t> split_hash_map_hash(std::uint64_t const hash,
+                std::size_t const slot_count) noexcept {
+            return {static_cast<std::uint8_t>(hash & 0x7F), static_cast<std::size_t>(hash >> 7) & (slot_count - 1)};
+        }
+
+    }
+
+
+    // Serialisable associative container which maps unique keys of type K to values of type V, stored as an
+    // open-addressing hash table. Can hold up to basic_max_dynamic_array_size<Format> / 2 entries.
+    // The table is built when serialising, and lookups probe it directly on the buffer in expected O(1) time.
+    // Hash is part of the format (see stable_hash). Hash and KeyEqual must be default constructible. KeyEqual must
+    // compare serialise_source<K> (used to detect duplicate keys when building the table) and deserialise_t<K> with
+    // lookup keys.
+    // Format determines the size of the entry count and offsets (see format_profile).
+    template<serialisable K, serialisable V, typename Hash = stable_hash<K>, typename KeyEqual = std::equal_to<>,
+        format_profile Format = compact_format>
+    struct hash_map {
+        using key_type = K;
+        using mapped_type = V;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using format = Format;
+    };
+
+    // hash_map which can hold more than 2^31 entries, and refer to variable data anywhere in a buffer larger than
+    // 4 GiB.
+    template<serialisable K, serialisable V, typename Hash = stable_hash<K>, typename KeyEqual = std::equal_to<>>
+    using large_hash_map = hash_map<K, V, Hash, KeyEqual, large_format>;
+
+
+    template<serialisable K, serialisable V, typename Hash, typename KeyEqual, format_profile Format>
+    struct fixed_data_size<hash_map<K, V, Hash, KeyEqual, Format>> : detail::size_t_constant<
+        2 * fixed_data_size_v<typename Format::size_type> + 3 * fixed_data_size_v<typename Format::offset_type>> {};
+
+
+    // Holds the entries by value, and builds the hash table on construction. Constructible from a braced-init-list of
+    // entries, a std::vector of entries, or any range of pair-like objects convertible to entries (e.g. a std::map or
+    // std::unordered_map).
+    // Throws std::invalid_argument if any keys are equal.
+    template<serialisable K, serialisable V, typename Hash, typename KeyEqual, format_profile Format>
+    class serialise_source<hash_map<K, V, Hash, KeyEqual, Format>> {
+    public:
+        using entry_type = std::pair<serialise_source<K>, serialise_source<V>>;
+
+        // Constructs with zero entries.
+        constexpr serialise_source() = default;
+
+        // Constructs from the entries of a braced-init-list.
+        template<std::size_t N>
+        constexpr serialise_source(entry_type (&& entries)[N]) {
+            _entries.reserve(N);
+            for (auto& entry : entries) {
+                _entries.push_back(std::move(entry));
+            }
+            _build();
+        }
+
+        // Takes ownership of the entries without copying them.
+        // (A template so that a braced-init-list is never implicitly converted to std::vector.)
+        template<std::same_as<std::vector<entry_type>> Vector>
+        constexpr serialise_source(Vector&& entries) :
+            _entries{std::move(entries)}
+        {
+            _build();
+        }
+
+        template<std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, entry_type>
+                && (!std::same_as<R, std::vector<entry_type>>)
+        constexpr serialise_source(R&& entries) {
+            if constexpr (std::ranges::sized_range<R>) {
+                _entries.reserve(std::ranges::size(entries));
+            }
+            for (auto&& entry : entries) {
+                _entries.emplace_back(std::forward<decltype(entry)>(entry));
+            }
+            _build();
+        }
+
+        // Gets the number of entries.
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _entries.size();
+        }
+
+        // Gets the number of slots in the hash table.
+        [[nodiscard]]
+        constexpr std::size_t slot_count() const noexcept {
+            return _slots.size();
+        }
+
+        // Gets the control bytes of the hash table (see hash_map format).
+        [[nodiscard]]
+        constexpr std::span<std::byte const> control() const noexcept {
+            return _control;
+        }
+
+        // Gets a view of the key in each slot.
+        [[nodiscard]]
+        constexpr auto keys() const {
+            return _slots | std::views::transform([this](std::size_t const index) -> serialise_source<K> const& {
+                return index != _empty_slot ? _entries[index].first : _empty_entry.first;
+            });
+        }
+
+        // Gets a view of the value in each slot.
+        [[nodiscard]]
+        constexpr auto values() const {
+            return _slots | std::views::transform([this](std::size_t const index) -> serialise_source<V> const& {
+                return index != _empty_slot ? _entries[index].second : _empty_entry.second;
+            });
+        }
+
+    private:
+        static constexpr std::size_t _empty_slot = std::numeric_limits<std::size_t>::max();
+
+        std::vector<entry_type> _entries;
+        // Index of the entry in each slot, or _empty_slot.
+        std::vector<std::size_t> _slots;
+        std::vector<std::byte> _control;
+        // Serialised into empty slots.
+        entry_type _empty_entry{};
+
+        constexpr void _build() {
+            auto const slot_count = detail::hash_map_slot_count(_entries.size());
+            if (slot_count == 0) {
+                return;
+            }
+            _slots.assign(slot_count, _empty_slot);
+            _control.assign(slot_count + detail::hash_map_group_size - 1,
+                std::byte{detail::hash_map_empty_control});
+
+            for (std::size_t index = 0; index < _entries.size(); ++index) {
+                auto const& key = _entries[index].first;
+                auto const [control, first_slot] =
+                    detail::split_hash_map_hash(static_cast<std::uint64_t>(Hash{}(key)), slot_count);
+                auto slot = first_slot;
+                // Load factor is < 1, so there is always an empty slot.
+                while (_slots[slot] != _empty_slot) {
+                    if (_control[slot] == std::byte{control} && KeyEqual{}(_entries[_slots[slot]].first, key)) {
+                        throw std::invalid_argument{"hash_map keys must be unique"};
+                    }
+                    slot = (slot + 1) & (slot_count - 1);
+                }
+                _slots[slot] = index;
+                _control[slot] = std::byte{control};
+                if (slot < detail::hash_map_group_size - 1) {
+                    _control[slot_count + slot] = std::byte{control};
+                }
+            }
+        }
+    };
+
+
+    template<serialisable K, serialisable V, typename Hash, typename KeyEqual, format_profile Format>
+    struct serialiser<hash_map<K, V, Hash, KeyEqual, Format>> {
+        static constexpr void serialise(serialise_source<hash_map<K, V, Hash, KeyEqual, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            using size_type = Format::size_type;
+            using offset_type = Format::offset_type;
+
+            auto const count = detail::to_dynamic_array_size<Format>(source.size());
+            auto const slot_count = source.slot_count();
+            offset_type control_offset = 0;
+            offset_type keys_offset = 0;
+            offset_type values_offset = 0;
+            if (slot_count > 0) {
+                auto const control = source.control();
+                control_offset = detail::to_data_offset<offset_type>(push_variable_subobjects<std::byte>(
+                    control.size(), buffer, [&buffer, control](std::size_t const offset) {
+                        std::ranges::copy(control, buffer.span().begin() + offset);
+                    }));
+                auto keys = source.keys();
+                keys_offset = detail::to_data_offset<offset_type>(
+                    detail::serialise_dynamic_array_elements<K>(keys, slot_count, buffer, nullptr));
+                auto values = source.values();
+                values_offset = detail::to_data_offset<offset_type>(
+                    detail::serialise_dynamic_array_elements<V>(values, slot_count, buffer, nullptr));
+            }
+
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<size_type>{count}, buffer));
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset, detail::bind_serialise(
+                serialise_source<size_type>{detail::to_dynamic_array_size<Format>(slot_count)}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{control_offset}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{keys_offset}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{values_offset}, buffer));
+        }
+
+        static constexpr std::size_t variable_data_size(
+                serialise_source<hash_map<K, V, Hash, KeyEqual, Format>> const& source)
+                requires size_precomputable<K> && size_precomputable<V> {
+            if (source.slot_count() == 0) {
+                return 0;
+            }
+            auto keys = source.keys();
+            auto values = source.values();
+            return source.control().size() + detail::dynamic_array_elements_size<K>(keys, source.slot_count())
+                + detail::dynamic_array_elements_size<V>(values, source.slot_count());
+        }
+    };
+
+
+    // Forward view of the entries of a serialised hash_map, in unspecified order, obtained from
+    // deserialiser<hash_map<K, V, Hash, KeyEqual, Format>>::entries().
+    // Each entry is a std::pair of deserialise_t<K> and deserialise_t<V>.
+    // References only the buffer, so may outlive the deserialiser it was obtained from. Likewise, iterators (including
+    // those returned by find()) may outlive the view.
+    template<serialisable K, serialisable V, typename Hash = stable_hash<K>, typename KeyEqual = std::equal_to<>>
+    class hash_map_view : public std::ranges::view_interface<hash_map_view<K, V, Hash, KeyEqual>> {
+    public:
+        using value_type = std::pair<deserialise_t<K>, deserialise_t<V>>;
+
+        class iterator {
+        public:
+            using value_type = hash_map_view::value_type;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            [[nodiscard]]
+            constexpr value_type operator*() const {
+                return {key(), value()};
+            }
+
+            // Gets the key of the entry, without deserialising the value.
+            [[nodiscard]]
+            constexpr deserialise_t<K> key() const {
+                return _keys[_slot];
+            }
+
+            // Gets the value of the entry, without deserialising the key.
+            [[nodiscard]]
+            constexpr deserialise_t<V> value() const {
+                return _values[_slot];
+            }
+
+            constexpr iterator& operator++() noexcept {
+                _slot = hash_map_view::_next_full_slot(_control, _keys.size(), _slot + 1);
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept {
+                auto const old = *this;
+                ++*this;
+                return old;
+            }
+
+            [[nodiscard]]
+            friend constexpr bool operator==(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._slot == rhs._slot;
+            }
+
+        private:
+            friend class hash_map_view;
+
+            // Copies of the view's control bytes and key and value views, which reference only the buffer, so the
+            // iterator remains valid after the view is destroyed.
+            const_bytes_span _control;
+            dynamic_array_view<K> _keys;
+            dynamic_array_view<V> _values;
+            std::size_t _slot = 0;
+
+            constexpr iterator(hash_map_view const& view, std::size_t const slot) noexcept :
+                _control{view._control}, _keys{view._keys}, _values{view._values}, _slot{slot}
+            {}
+        };
+
+        hash_map_view() = default;
+
+        // control must contain at least keys.size() + 7 bytes, and keys and values must have the same size, which is
+        // 0 or a power of two >= 8.
+        constexpr hash_map_view(std::size_t const size, const_bytes_span const control,
+                dynamic_array_view<K> const keys, dynamic_array_view<V> const values) noexcept :
+            _size{size}, _control{control}, _keys{keys}, _values{values}
+        {
+            assert(keys.size() == values.size());
+            assert(keys.size() == 0 || control.size() >= keys.size() + detail::hash_map_group_size - 1);
+        }
+
+        [[nodiscard]]
+        constexpr iterator begin() const noexcept {
+            return iterator{*this, _next_full_slot(_control, slot_count(), 0)};
+        }
+
+        [[nodiscard]]
+        constexpr iterator end() const noexcept {
+            return iterator{*this, slot_count()};
+        }
+
+        // Gets the number of entries.
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        // Gets the number of slots in the hash table.
+        [[nodiscard]]
+        constexpr std::size_t slot_count() const noexcept {
+            return _keys.size();
+        }
+
+        // Gets an iterator to the entry whose key is equal to key, or end() if there is none.
+        // Control bytes are compared 8 at a time, and only keys whose control byte matches are deserialised.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr iterator find(Key const& key) const {
+            auto const slot_count = this->slot_count();
+            if (slot_count == 0) {
+                return end();
+            }
+            auto const [control, first_slot] =
+                detail::split_hash_map_hash(static_cast<std::uint64_t>(Hash{}(key)), slot_count);
+            auto group_slot = first_slot;
+            // Bounded in case the buffer is malformed and has no empty slots.
+            for (std::size_t probed = 0; probed < slot_count; probed += detail::hash_map_group_size) {
+                auto const group = detail::load_hash_map_group(_control, group_slot);
+                for (auto matches = detail::match_hash_map_group(group, control); matches != 0;
+                        matches &= matches - 1) {
+                    auto const slot = (group_slot + static_cast<std::size_t>(std::countr_zero(matches)) / 8)
+                        & (slot_count - 1);
+                    if (KeyEqual{}(_keys[slot], key)) {
+                        return iterator{*this, slot};
+                    }
+                }
+                if (detail::match_hash_map_group_empty(group) != 0) {
+                    break;
+                }
+                group_slot = (group_slot + detail::hash_map_group_size) & (slot_count - 1);
+            }
+            return end();
+        }
+
+        // Checks if there is an entry whose key is equal to key.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr bool contains(Key const& key) const {
+            return find(key) != end();
+        }
+
+    private:
+        std::size_t _size = 0;
+        const_bytes_span _control;
+        dynamic_array_view<K> _keys;
+        dynamic_array_view<V> _values;
+
+        // Gets the first slot >= slot which is full, or slot_count if there is none.
+        [[nodiscard]]
+        static constexpr std::size_t _next_full_slot(const_bytes_span const control, std::size_t const slot_count,
+                std::size_t slot) noexcept {
+            while (slot < slot_count && control[slot] == std::byte{detail::hash_map_empty_control}) {
+                ++slot;
+            }
+            return slot;
+        }
+    };
+
+
+    template<serialisable K, serialisable V, typename Hash, typename KeyEqual, format_profile Format>
+    class deserialiser<hash_map<K, V, Hash, KeyEqual, Format>> : public deserialiser_base {
+    public:
+        using deserialiser_base::deserialiser_base;
+
+        // Gets the number of entries.
+        [[nodiscard]]
+        constexpr std::size_t size() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
+        }
+
+        // Checks if there are zero entries.
+        [[nodiscard]]
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        // Gets the number of slots in the hash table.
+        [[nodiscard]]
+        constexpr std::size_t slot_count() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(
+                _fixed_offset + fixed_data_size_v<typename Format::size_type>));
+        }
+
+        // Gets a view of the entries, which supports lookups with find().
+        // Throws buffer_bounds_error if the hash table is out of bounds, or invalid_value_error if the slot count is
+        // not valid.
+        [[nodiscard]]
+        constexpr hash_map_view<K, V, Hash, KeyEqual> entries() const {
+            auto const slot_count = this->slot_count();
+            if (slot_count == 0) {
+                return {};
+            }
+            if (slot_count < detail::hash_map_group_size || !std::has_single_bit(slot_count)) {
+                throw invalid_value_error{
+                    std::format("hash_map slot count {} is not a power of two >= {}", slot_count,
+                        detail::hash_map_group_size)};
+            }
+            auto const control_offset = _offset(0);
+            auto const control_size = slot_count + detail::hash_map_group_size - 1;
+            // Always bounds checked, since probing relies on it.
+            detail::check_buffer_size_for_elements<std::byte>(_buffer, control_offset, control_size);
+            return hash_map_view<K, V, Hash, KeyEqual>{size(), _buffer.subspan(control_offset, control_size),
+                _elements<K>(slot_count, 1), _elements<V>(slot_count, 2)};
+        }
+
+        // Gets the value whose key is equal to key, or an empty std::optional if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr std::optional<deserialise_t<V>> find(Key const& key) const {
+            auto const entries = this->entries();
+            if (auto const it = entries.find(key); it != entries.end()) {
+                return it.value();
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+
+        // Checks if there is an entry whose key is equal to key.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr bool contains(Key const& key) const {
+            return entries().contains(key);
+        }
+
+        // Gets the value whose key is equal to key. Throws std::out_of_range if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr deserialise_t<V> at(Key const& key) const {
+            if (auto value = find(key)) {
+                return *std::move(value);
+            }
+            else {
+                throw std::out_of_range{"key not found in hash_map"};
+            }
+        }
+
+        // Checks that the hash table is within the buffer and consistent with the entry count, and validates each
+        // key's and value's subobjects.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires validatable<K> && validatable<V> {
+            auto const size = this->size();
+            auto const slot_count = this->slot_count();
+            if (slot_count == 0) {
+                if (size != 0) {
+                    throw invalid_value_error{std::format("hash_map with {} entries has no slots", size)};
+                }
+                return;
+            }
+
+            (void)entries();
+            auto const control = _buffer.subspan(_offset(0), slot_count + detail::hash_map_group_size - 1);
+            std::size_t full_count = 0;
+            for (std::size_t slot = 0; slot < control.size(); ++slot) {
+                auto const value = std::to_integer<std::uint8_t>(control[slot]);
+                if (value > detail::hash_map_empty_control) {
+                    throw invalid_value_error{
+                        std::format("hash_map control byte {} at slot {} is invalid", value, slot)};
+                }
+                if (slot >= slot_count && control[slot] != control[slot - slot_count]) {
+                    throw invalid_value_error{
+                        std::format("hash_map control byte at slot {} does not match slot {}", slot,
+                            slot - slot_count)};
+                }
+                full_count += slot < slot_count && value != detail::hash_map_empty_control;
+            }
+            if (full_count != size || size >= slot_count) {
+                throw invalid_value_error{
+                    std::format("hash_map has {} entries, but {} of {} slots are full", size, full_count, slot_count)};
+            }
+
+            _validate_elements<K>(slot_count, 1, parallel);
+            _validate_elements<V>(slot_count, 2, parallel);
+        }
+
+    private:
+        // Gets the control bytes' (offset_index 0), keys' (offset_index 1) or values' (offset_index 2) offset.
+        [[nodiscard]]
+        constexpr std::size_t _offset(std::size_t const offset_index) const {
+            auto const offset_offset = _fixed_offset + 2 * fixed_data_size_v<typename Format::size_type>
+                + fixed_data_size_v<typename Format::offset_type> * offset_index;
+            return static_cast<std::size_t>(_deserialise<typename Format::offset_type>(offset_offset));
+        }
+
+        template<serialisable T>
+        [[nodiscard]]
+        constexpr dynamic_array_view<T> _elements(std::size_t const slot_count, std::size_t const offset_index) const {
+            // Always bounds checked, since probing may access any slot.
+            return dynamic_array_view<T>{_buffer, _offset(offset_index), slot_count, true};
+        }
+
+        template<serialisable T>
+        constexpr void _validate_elements(std::size_t const slot_count, std::size_t const offset_index,
+                parallel_executor const* const parallel) const {
+            if constexpr (!fixed_size_serialisable<T>) {
+                auto const offset = _offset(offset_index);
+                for (std::size_t i = 0; i < slot_count; ++i) {
+                    detail::validate_subobjects<T>(_buffer, offset + fixed_data_size_v<T> * i, parallel);
+                }
+            }
+        }
+    };
+
+}
+
+
+namespace std::ranges {
+
+    // Iterators of hash_map_view reference only the buffer, so they may outlive the view.
+    template<::serialpp::serialisable K, ::serialpp::serialisable V, typename Hash, typename KeyEqual>
+    inline constexpr bool enable_borrowed_range<::serialpp::hash_map_view<K, V, Hash, KeyEqual>> = true;
+
+}
@@ -0,0 +1,443 @@
+#pragma once
+
+// Buffers based on memory mapping. Only available on POSIX platforms.
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "common.hpp"
+
+
+namespace serialpp {
+
+    namespace detail {
+
+        [[noreturn]]
+        inline void throw_errno(char const* const what) {
+            throw std::system_error{errno, std::generic_category(), what};
+        }
+
+
+        // RAII owner of a POSIX file descriptor.
+        class unique_fd {
+        public:
+            explicit unique_fd(int const fd = -1) noexcept :
+                _fd{fd}
+            {}
+
+            unique_fd(unique_fd&& other) noexcept :
+                _fd{std::exchange(other._fd, -1)}
+            {}
+
+            ~unique_fd() {
+                if (_fd >= 0) {
+                    ::close(_fd);
+                }
+            }
+
+            unique_fd& operator=(unique_fd other) noexcept {
+                std::swap(_fd, other._fd);
+                return *this;
+            }
+
+            [[nodiscard]]
+            int get() const noexcept {
+                return _fd;
+            }
+
+        private:
+            int _fd;
+        };
+
+
+        // Maps size bytes of a file into memory. Returns nullptr if size is 0.
+        [[nodiscard]]
+        inline std::byte* map_file(int const fd, std::size_t const size, int const protection) {
+            if (size == 0) {
+                return nullptr;
+            }
+            void* const data = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                throw_errno("mmap() failed");
+            }
+            return static_cast<std::byte*>(data);
+        }
+
+        inline void unmap_file(std::byte* const data, std::size_t const size) noexcept {
+            if (data) {
+                ::munmap(data, size);
+            }
+        }
+
+    }
+
+
+    // serialise_buffer implementation that uses a memory-mapped file for storage.
+    // The file is grown and remapped as necessary to extend the buffer while serialising. The serialised bytes are
+    // written directly into the OS page cache, so no separate copy to the file is required.
+    // On destruction (or sync()), the file is truncated to the used size, so that it contains exactly the bytes of
+    // span().
+    class mmap_file_buffer {
+    public:
+        // path is the file to serialise into. It is created if it doesn't exist, and its previous content is discarded.
+        // capacity is the number of bytes to preallocate in the file.
+        // Throws std::system_error if the file can't be opened or mapped.
+        explicit mmap_file_buffer(std::filesystem::path const& path, std::size_t const capacity = 1 << 20) :
+            _fd{::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666)},
+            _data{nullptr},
+            _capacity{0},
+            _used{0}
+        {
+            if (_fd.get() < 0) {
+                detail::throw_errno("open() failed");
+            }
+            _reserve(capacity);
+        }
+
+        mmap_file_buffer(mmap_file_buffer&& other) noexcept :
+            _fd{std::move(other._fd)},
+            _data{std::exchange(other._data, nullptr)},
+            _capacity{std::exchange(other._capacity, 0)},
+            _used{std::exchange(other._used, 0)}
+        {}
+
+        ~mmap_file_buffer() {
+            detail::unmap_file(_data, _capacity);
+            if (_fd.get() >= 0) {
+                // Best effort, nothing sensible to do on failure.
+                (void)::ftruncate(_fd.get(), static_cast<off_t>(_used));
+            }
+        }
+
+        mmap_file_buffer& operator=(mmap_file_buffer other) noexcept {
+            swap(*this, other);
+            return *this;
+        }
+
+        // Sets the size in bytes of the buffer, ready for a new serialisation.
+        // If size is greater than the current capacity, the file is grown and remapped, and any view of the buffer
+        // previously acquired from span() will be invalidated. The newly allocated memory is not initialised.
+        // Returns the new value of span().
+        mutable_bytes_span initialise(std::size_t const size) {
+            if (_capacity < size) {
+                _reserve(size);
+            }
+            _used = size;
+            return span();
+        }
+
+        // Extends the buffer by count bytes, while maintaining the previous content.
+        // If the new size is greater than the current capacity, the file is grown and remapped, and any view of the
+        // buffer previously acquired from span() will be invalidated. The new extended section of memory is not
+        // initialised.
+        // Returns the new value of span().
+        mutable_bytes_span extend(std::size_t const count) {
+            auto const new_used = _used + count;
+            if (_capacity < new_used) {
+                _reserve(static_cast<std::size_t>(new_used * 1.5));
+            }
+            _used = new_used;
+            return span();
+        }
+
+        // Shrinks the buffer to size bytes, keeping the previous content before size. Never remaps.
+        // Returns the new value of span().
+        mutable_bytes_span truncate(std::size_t const size) noexcept {
+            assert(size <= _used);
+            _used = size;
+            return span();
+        }
+
+        [[nodiscard]]
+        const_bytes_span span() const noexcept {
+            return {_data, _used};
+        }
+
+        [[nodiscard]]
+        mutable_bytes_span span() noexcept {
+            return {_data, _used};
+        }
+
+        [[nodiscard]]
+        std::size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        // Truncates the file to the used size and flushes the mapping to the file.
+        // Throws std::system_error on failure.
+        void sync() {
+            if (_used < _capacity) {
+                // Shrink the mapping first, so no part of it extends past the end of the file.
+                _remap(_used);
+                if (::ftruncate(_fd.get(), static_cast<off_t>(_used)) != 0) {
+                    detail::throw_errno("ftruncate() failed");
+                }
+            }
+            if (_data && ::msync(_data, _capacity, MS_SYNC) != 0) {
+                detail::throw_errno("msync() failed");
+            }
+        }
+
+        friend void swap(mmap_file_buffer& first, mmap_file_buffer& second) noexcept {
+            using std::swap;
+            swap(first._fd, second._fd);
+            swap(first._data, second._data);
+            swap(first._capacity, second._capacity);
+            swap(first._used, second._used);
+        }
+
+    private:
+        detail::unique_fd _fd;
+        std::byte* _data;
+        std::size_t _capacity;      // Number of bytes in the file and mapping.
+        std::size_t _used;          // Number of bytes used at the start of the mapping.
+
+        // Grows the file and mapping to new_capacity bytes.
+        void _reserve(std::size_t const new_capacity) {
+            assert(new_capacity >= _capacity);
+            if (::ftruncate(_fd.get(), static_cast<off_t>(new_capacity)) != 0) {
+                detail::throw_errno("ftruncate() failed");
+            }
+            _remap(new_capacity);
+        }
+
+        // Changes the size of the mapping to new_capacity bytes, maintaining its content.
+        // If growing, the file must already be at least new_capacity bytes.
+        void _remap(std::size_t const new_capacity) {
+            if (new_capacity == _capacity) {
+                return;
+            }
+            std::byte* new_data;
+            if (!_data || new_capacity == 0) {
+                new_data = detail::map_file(_fd.get(), new_capacity, PROT_READ | PROT_WRITE);
+                detail::unmap_file(_data, _capacity);
+            }
+            else {
+#ifdef __linux__
+                // mremap() avoids tearing down the existing page mappings.
+                void* const result = ::mremap(_data, _capacity, new_capacity, MREMAP_MAYMOVE);
+                if (result == MAP_FAILED) {
+                    detail::throw_errno("mremap() failed");
+                }
+                new_data = static_cast<std::byte*>(result);
+#else
+                // The mapping is shared with the file, so no content is lost by remapping.
+                new_data = detail::map_file(_fd.get(), new_capacity, PROT_READ | PROT_WRITE);
+                detail::unmap_file(_data, _capacity);
+#endif
+            }
+            _data = new_data;
+            _capacity = new_capacity;
+        }
+    };
+
+
+    // Read-only memory mapping of an entire file, e.g. for deserialising a file written with mmap_file_buffer.
+    // Deserialisers obtained from span() read directly from the OS page cache, without copying the file content.
+    class mmap_file_view {
+    public:
+        // Maps the file at path.
+        // Throws std::system_error if the file can't be opened or mapped.
+        explicit mmap_file_view(std::filesystem::path const& path) :
+            _data{nullptr},
+            _size{0}
+        {
+            detail::unique_fd const fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+            if (fd.get() < 0) {
+                detail::throw_errno("open() failed");
+            }
+            struct ::stat file_stat{};
+            if (::fstat(fd.get(), &file_stat) != 0) {
+                detail::throw_errno("fstat() failed");
+            }
+            auto const size = static_cast<std::size_t>(file_stat.st_size);
+            // The mapping remains valid after the file descriptor is closed.
+            _data = detail::map_file(fd.get(), size, PROT_READ);
+            _size = size;
+        }
+
+        mmap_file_view(mmap_file_view&& other) noexcept :
+            _data{std::exchange(other._data, nullptr)},
+            _size{std::exchange(other._size, 0)}
+        {}
+
+        ~mmap_file_view() {
+            detail::unmap_file(_data, _size);
+        }
+
+        mmap_file_view& operator=(mmap_file_view other) noexcept {
+            swap(*this, other);
+            return *this;
+        }
+
+        [[nodiscard]]
+        const_bytes_span span() const noexcept {
+            return {_data, _size};
+        }
+
+        friend void swap(mmap_file_view& first, mmap_file_view& second) noexcept {
+            using std::swap;
+            swap(first._data, second._data);
+            swap(first._size, second._size);
+        }
+
+    private:
+        std::byte* _data;
+        std::size_t _size;
+    };
+
+
+    // serialise_buffer implementation that reserves a large range of virtual address space up front, and commits memory
+    // within it as the buffer is extended.
+    // Unlike basic_buffer, extending never reallocates or copies the previous content, and span() never moves, so
+    // growth remains cheap for very large objects. Physical memory is only used for the pages that are written to.
+    // If the reserved size is exceeded, std::bad_alloc is thrown.
+    class reserved_buffer {
+    public:
+        // Default maximum size: 8 GiB, which is enough for any object in the default compact_format, since its
+        // variable data offsets are limited to 32 bits. Capped to the largest std::size_t where that is smaller.
+        static constexpr std::size_t default_max_size =
+            static_cast<std::size_t>(std::min<std::uint64_t>(std::uint64_t{1} << 33,
+                std::numeric_limits<std::size_t>::max()));
+
+        // max_size is the number of bytes of address space to reserve, i.e. the maximum size of the buffer.
+        // Objects in large_format may need more than the default.
+        // Throws std::system_error if the address space can't be reserved.
+        explicit reserved_buffer(std::size_t const max_size = default_max_size) :
+            _data{nullptr},
+            _reserved{max_size},
+            _committed{0},
+            _used{0}
+        {
+            if (_reserved > 0) {
+                void* const data = ::mmap(nullptr, _reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                    -1, 0);
+                if (data == MAP_FAILED) {
+                    detail::throw_errno("mmap() failed");
+                }
+                _data = static_cast<std::byte*>(data);
+            }
+        }
+
+        reserved_buffer(reserved_buffer&& other) noexcept :
+            _data{std::exchange(other._data, nullptr)},
+            _reserved{std::exchange(other._reserved, 0)},
+            _committed{std::exchange(other._committed, 0)},
+            _used{std::exchange(other._used, 0)}
+        {}
+
+        ~reserved_buffer() {
+            if (_data) {
+                ::munmap(_data, _reserved);
+            }
+        }
+
+        reserved_buffer& operator=(reserved_buffer other) noexcept {
+            swap(*this, other);
+            return *this;
+        }
+
+        // Sets the size in bytes of the buffer, ready for a new serialisation.
+        // Never invalidates views of the buffer previously acquired from span(). The newly committed memory is
+        // zero-initialised, but memory reused from a previous serialisation is not.
+        // If size is greater than the reserved size, std::bad_alloc is thrown.
+        // Returns the new value of span().
+        mutable_bytes_span initialise(std::size_t const size) {
+            _commit(size);
+            _used = size;
+            return span();
+        }
+
+        // Extends the buffer by count bytes, while maintaining the previous content.
+        // Never invalidates views of the buffer previously acquired from span().
+        // If the new size is greater than the reserved size, std::bad_alloc is thrown.
+        // Returns the new value of span().
+        mutable_bytes_span extend(std::size_t const count) {
+            if (_reserved - _used < count) {
+                throw std::bad_alloc{};
+            }
+            auto const new_used = _used + count;
+            _commit(new_used);
+            _used = new_used;
+            return span();
+        }
+
+        // Shrinks the buffer to size bytes, keeping the previous content before size. The memory stays committed.
+        // Returns the new value of span().
+        mutable_bytes_span truncate(std::size_t const size) noexcept {
+            assert(size <= _used);
+            _used = size;
+            return span();
+        }
+
+        [[nodiscard]]
+        const_bytes_span span() const noexcept {
+            return {_data, _used};
+        }
+
+        [[nodiscard]]
+        mutable_bytes_span span() noexcept {
+            return {_data, _used};
+        }
+
+        // Gets the number of bytes which are currently committed, i.e. usable without another system call.
+        [[nodiscard]]
+        std::size_t capacity() const noexcept {
+            return _committed;
+        }
+
+        // Gets the maximum size of the buffer.
+        [[nodiscard]]
+        std::size_t max_size() const noexcept {
+            return _reserved;
+        }
+
+        friend void swap(reserved_buffer& first, reserved_buffer& second) noexcept {
+            using std::swap;
+            swap(first._data, second._data);
+            swap(first._reserved, second._reserved);
+            swap(first._committed, second._committed);
+            swap(first._used, second._used);
+        }
+
+    private:
+        std::byte* _data;
+        std::size_t _reserved;      // Number of bytes of address space reserved.
+        std::size_t _committed;     // Number of bytes at the start of the reserved space which are accessible.
+        std::size_t _used;          // Number of bytes used at the start of the reserved space.
+
+        // Ensures at least size bytes are committed.
+        void _commit(std::size_t const size) {
+            if (size <= _committed) {
+                return;
+            }
+            if (size > _reserved) {
+                throw std::bad_alloc{};
+            }
+            // Commit in geometrically increasing steps to keep the number of system calls low.
+            static std::size_t const page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            auto new_committed = std::max(size, _committed * 2);
+            new_committed = (new_committed + page_size - 1) / page_size * page_size;
+            new_committed = std::min(new_committed, _reserved);
+            if (::mprotect(_data + _committed, new_committed - _committed, PROT_READ | PROT_WRITE) != 0) {
+                throw std::bad_alloc{};
+            }
+            _committed = new_committed;
+        }
+    };
+
+}
@@ -12,52 +12,70 @@ namespace serialpp {
 
     /*
         optional:
-            Fixed data is an offset (data_offset_t) that indicates both if there is a contained value, and the offset of
-            the value (if present).
+            Fixed data is an offset (Format::offset_type) that indicates both if there is a contained value, and the
+            offset of the value (if present).
             If the offset is 0, then there is no value and no variable data is present.
             If the offset is > 0, then the value starts at byte [offset - 1].
     */
 
 
     // Serialisable type which contains either zero or one instance of a type.
-    template<serialisable T>
+    // Format determines the size of the offset (see format_profile).
+    template<serialisable T, format_profile Format = compact_format>
     struct optional {
         using value_type = T;
+        using format = Format;
     };
 
-
+    // optional which can refer to variable data anywhere in a buffer larger than 4 GiB.
     template<serialisable T>
-    struct fixed_data_size<optional<T>> : fixed_data_size<data_offset_t> {};
+    using large_optional = optional<T, large_format>;
 
 
-    template<serialisable T>
-    class serialise_source<optional<T>> : public std::optional<serialise_source<T>> {
+    template<serialisable T, format_profile Format>
+    struct fixed_data_size<optional<T, Format>> : fixed_data_size<typename Format::offset_type> {};
+
+
+    template<serialisable T, format_profile Format>
+    class serialise_source<optional<T, Format>> : public std::optional<serialise_source<T>> {
     public:
         using std::optional<serialise_source<T>>::optional;
     };
 
 
-    template<serialisable T>
-    struct serialiser<optional<T>> {
-        static constexpr void serialise(serialise_source<optional<T>> const& source, serialise_buffer auto& buffer,
-                std::size_t fixed_offset) {
+    template<serialisable T, format_profile Format>
+    struct serialiser<optional<T, Format>> {
+        static constexpr void serialise(serialise_source<optional<T, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            using offset_type = Format::offset_type;
+            if (source.has_value()) {
+                // Value is serialised first, since the buffer may relocate it if it deduplicates variable data.
+                auto const variable_offset =
+                    push_variable_subobjects<T>(1, buffer, detail::bind_serialise(source.value(), buffer));
+                auto const offset = detail::to_data_offset<offset_type>(variable_offset + 1);
+                fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                    detail::bind_serialise(serialise_source<offset_type>{offset}, buffer));
+            }
+            else {
+                fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                    detail::bind_serialise(serialise_source<offset_type>{0}, buffer));
+            }
+        }
+
+        static constexpr std::size_t variable_data_size(serialise_source<optional<T, Format>> const& source)
+                requires size_precomputable<T> {
             if (source.has_value()) {
-                auto const variable_offset = buffer.span().size();
-                auto const offset = detail::to_data_offset(variable_offset + 1);
-                fixed_offset = push_fixed_subobject<data_offset_t>(fixed_offset,
-                    detail::bind_serialise(serialise_source<data_offset_t>{offset}, buffer));
-                push_variable_subobjects<T>(1, buffer, detail::bind_serialise(source.value(), buffer));
+                return fixed_data_size_v<T> + serialpp::variable_data_size<T>(source.value());
             }
             else {
-                fixed_offset = push_fixed_subobject<data_offset_t>(fixed_offset,
-                    detail::bind_serialise(serialise_source<data_offset_t>{0}, buffer));
+                return 0;
             }
         }
     };
 
 
-    template<serialisable T>
-    class deserialiser<optional<T>> : public deserialiser_base {
+    template<serialisable T, format_profile Format>
+    class deserialiser<optional<T, Format>> : public deserialiser_base {
     public:
         using deserialiser_base::deserialiser_base;
 
@@ -74,7 +92,7 @@ namespace serialpp {
             auto offset = _value_offset();
             assert(offset > 0);
             offset -= 1;
-            return deserialise<T>(_buffer, offset);
+            return _deserialise<T>(offset);
         }
 
         // Gets the contained value. If has_value() is false, throws std::bad_optional_access.
@@ -88,12 +106,21 @@ namespace serialpp {
             }
         }
 
+        // Checks that the contained value, if any, can be deserialised.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires validatable<T> {
+            auto const offset = _value_offset();
+            if (offset > 0) {
+                detail::validate_object<T>(_buffer, offset - 1, parallel);
+            }
+        }
+
     private:
         // Offset from start of variable data section to contained value, plus 1.
         // 0 indicates no contained value, i.e. empty optional.
         [[nodiscard]]
-        constexpr data_offset_t _value_offset() const {
-            return deserialise<data_offset_t>(_buffer, _fixed_offset);
+        constexpr std::size_t _value_offset() const {
+            return _deserialise<typename Format::offset_type>(_fixed_offset);
         }
     };
 
@@ -44,6 +44,11 @@ namespace serialpp {
             fixed_offset = push_fixed_subobject<T1>(fixed_offset, detail::bind_serialise(source.first, buffer));
             fixed_offset = push_fixed_subobject<T2>(fixed_offset, detail::bind_serialise(source.second, buffer));
         }
+
+        static constexpr std::size_t variable_data_size(serialise_source<pair<T1, T2>> const& source)
+                requires size_precomputable<T1> && size_precomputable<T2> {
+            return serialpp::variable_data_size<T1>(source.first) + serialpp::variable_data_size<T2>(source.second);
+        }
     };
 
 
@@ -55,13 +60,13 @@ namespace serialpp {
         // Gets the first element.
         [[nodiscard]]
         constexpr deserialise_t<T1> first() const {
-            return deserialise<T1>(_buffer, _fixed_offset);
+            return _deserialise<T1>(_fixed_offset);
         }
 
         // Gets the second element.
         [[nodiscard]]
         constexpr deserialise_t<T2> second() const {
-            return deserialise<T2>(_buffer, _fixed_offset + fixed_data_size_v<T1>);
+            return _deserialise<T2>(_fixed_offset + fixed_data_size_v<T1>);
         }
 
         // Gets an element by index.
@@ -78,6 +83,13 @@ namespace serialpp {
                 static_assert(Index <= 1);
             }
         }
+
+        // Validates each element's subobjects.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires validatable<T1> && validatable<T2> {
+            detail::validate_subobjects<T1>(_buffer, _fixed_offset, parallel);
+            detail::validate_subobjects<T2>(_buffer, _fixed_offset + fixed_data_size_v<T1>, parallel);
+        }
     };
 
 }
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "buffers.hpp"
+#include "common.hpp"
+#include "dynamic_array.hpp"
+
+
+namespace serialpp {
+
+    // Requests that an operation be split over multiple threads.
+    struct parallel_options {
+        // Maximum number of threads to use, including the calling thread.
+        std::size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        // Minimum number of elements processed by each thread. Splitting smaller amounts of work isn't worth the
+        // overhead of starting threads.
+        std::size_t min_elements_per_thread = 4096;
+
+        // Gets the number of slices to split element_count elements into.
+        [[nodiscard]]
+        constexpr std::size_t slice_count(std::size_t const element_count) const noexcept {
+            auto const max_slices = element_count / std::max<std::size_t>(min_elements_per_thread, 1);
+            return std::max<std::size_t>(std::min(thread_count, max_slices), 1);
+        }
+    };
+
+
+    namespace detail {
+
+        // Invokes func(i) for each i in [0, count), each on a separate thread (i == 0 on the calling thread).
+        // Returns once all invocations have completed. If any invocation throws, one of the exceptions is rethrown.
+        template<std::invocable<std::size_t> F>
+        void parallel_invoke(std::size_t const count, F&& func) {
+            std::vector<std::exception_ptr> errors(count);
+            auto const invoke = [&func, &errors](std::size_t const i) noexcept {
+                try {
+                    std::invoke(func, i);
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            };
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(count > 0 ? count - 1 : 0);
+                for (std::size_t i = 1; i < count; ++i) {
+                    threads.emplace_back(invoke, i);
+                }
+                if (count > 0) {
+                    invoke(0);
+                }
+                // Threads are joined here.
+            }
+            for (auto const& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        // Invokes func(thread_index, begin, end) for consecutive chunks [begin, end) of [0, count), on
+        // parallel.slice_count(count) threads.
+        // Threads claim chunks dynamically, so work is balanced even if some elements take longer than others.
+        template<std::invocable<std::size_t, std::size_t, std::size_t> F>
+        void parallel_for_chunks(std::size_t const count, parallel_options const& parallel, F&& func) {
+            auto const thread_count = parallel.slice_count(count);
+            // Several chunks per thread allows for balancing, while keeping the synchronisation overhead small.
+            auto const chunk_size = std::max<std::size_t>(count / (thread_count * 8), 1);
+            std::atomic<std::size_t> next_chunk_begin = 0;
+            parallel_invoke(thread_count, [&](std::size_t const thread_index) {
+                while (true) {
+                    auto const begin = next_chunk_begin.fetch_add(chunk_size, std::memory_order_relaxed);
+                    if (begin >= count) {
+                        break;
+                    }
+                    std::invoke(func, thread_index, begin, std::min(begin + chunk_size, count));
+                }
+            });
+        }
+
+
+        // parallel_executor which starts threads for each operation, as specified by parallel_options.
+        class thread_executor final : public parallel_executor {
+        public:
+            explicit thread_executor(parallel_options const& options) noexcept :
+                _options{options}
+            {}
+
+            [[nodiscard]]
+            std::size_t slice_count(std::size_t const element_count) const noexcept final {
+                return _options.slice_count(element_count);
+            }
+
+            void invoke(std::size_t const count, std::function<void(std::size_t)> const& func) const final {
+                parallel_invoke(count, func);
+            }
+
+            void for_chunks(std::size_t const count, std::function<void(std::size_t, std::size_t)> const& func) const
+                    final {
+                parallel_for_chunks(count, _options,
+                    [&func](std::size_t, std::size_t const begin, std::size_t const end) {
+                        func(begin, end);
+                    });
+            }
+
+        private:
+            parallel_options _options;
+        };
+
+
+        // serialise_buffer which wraps another buffer, and requests that large dynamic_arrays serialised into it are
+        // serialised on multiple threads.
+        template<serialise_buffer B>
+        class parallel_serialise_buffer {
+        public:
+            // buffer and parallel must outlive this object.
+            parallel_serialise_buffer(B& buffer, parallel_executor const& parallel) noexcept :
+                _buffer{buffer},
+                _parallel{parallel}
+            {}
+
+            mutable_bytes_span initialise(std::size_t const size) {
+                return _buffer.initialise(size);
+            }
+
+            mutable_bytes_span extend(std::size_t const count) {
+                return _buffer.extend(count);
+            }
+
+            [[nodiscard]]
+            mutable_bytes_span span() noexcept {
+                return _buffer.span();
+            }
+
+            std::size_t deduplicate(std::size_t const offset) requires deduplicating_buffer<B> {
+                return _buffer.deduplicate(offset);
+            }
+
+            [[nodiscard]]
+            parallel_executor const* parallel() const noexcept {
+                return &_parallel;
+            }
+
+        private:
+            B& _buffer;
+            parallel_executor const& _parallel;
+        };
+
+    }
+
+
+    // Initialises the buffer and serialises an entire object beginning from the start of the buffer, like
+    // serialise(source, buffer). However, the elements of large dynamic_arrays are serialised on multiple threads.
+    // Parallel serialisation is only used for arrays whose range is random access and whose T is size_precomputable.
+    // The serialised bytes are identical to sequential serialisation. The elements' serialise_sources must be safe to
+    // serialise concurrently.
+    template<serialisable T>
+    void serialise(parallel_options const& parallel, serialise_source<T> const& source,
+            serialise_buffer auto& buffer) {
+        detail::thread_executor const executor{parallel};
+        detail::parallel_serialise_buffer parallel_buffer{buffer, executor};
+        serialise(source, parallel_buffer);
+    }
+
+
+    // Like validate(buffer, fixed_offset), but large dynamic_arrays are validated on multiple threads.
+    template<validatable T>
+    [[nodiscard]]
+    deserialise_t<T> validate(parallel_options const& parallel, const_bytes_span const buffer,
+            std::size_t const fixed_offset = 0) {
+        detail::thread_executor const executor{parallel};
+        detail::validate_object<T>(buffer, fixed_offset, &executor);
+        return detail::unchecked_deserialise<T>(buffer, fixed_offset);
+    }
+
+
+    // Invokes func with each element of array (as deserialise_t<T>), split over multiple threads.
+    // The order of invocations is unspecified, and func may be invoked concurrently.
+    // If any invocation throws, one of the exceptions is rethrown after all threads have finished.
+    template<serialisable T, format_profile Format, std::invocable<deserialise_t<T>> F>
+    void parallel_for_each(deserialiser<dynamic_array<T, Format>> const& array, F&& func,
+            parallel_options const& parallel = {}) {
+        auto const elements = array.elements();
+        detail::parallel_for_chunks(elements.size(), parallel,
+                [&elements, &func](std::size_t, std::size_t const begin, std::size_t const end) {
+            for (auto i = begin; i < end; ++i) {
+                std::invoke(func, elements[i]);
+            }
+        });
+    }
+
+
+    // Computes reduce(init, transform(element)...) over each element of array, split over multiple threads.
+    // Like std::transform_reduce, reduce must be associative and commutative, since the order in which elements are
+    // combined is unspecified.
+    template<serialisable T, format_profile Format, typename R, typename Reduce,
+            std::invocable<deserialise_t<T>> Transform>
+        requires std::convertible_to<std::invoke_result_t<Transform&, deserialise_t<T>>, R>
+            && std::convertible_to<std::invoke_result_t<Reduce&, R, R>, R>
+    [[nodiscard]]
+    R parallel_reduce(deserialiser<dynamic_array<T, Format>> const& array, R init, Reduce reduce, Transform transform,
+            parallel_options const& parallel = {}) {
+        auto const elements = array.elements();
+        auto const size = elements.size();
+        // Each thread reduces into its own partial result, which are combined at the end.
+        std::vector<std::optional<R>> partials(parallel.slice_count(size));
+        detail::parallel_for_chunks(size, parallel,
+                [&](std::size_t const thread_index, std::size_t const begin, std::size_t const end) {
+            auto& partial = partials[thread_index];
+            for (auto i = begin; i < end; ++i) {
+                if (partial) {
+                    partial = std::invoke(reduce, std::move(*partial), R(std::invoke(transform, elements[i])));
+                }
+                else {
+                    partial.emplace(std::invoke(transform, elements[i]));
+                }
+            }
+        });
+        for (auto& partial : partials) {
+            if (partial) {
+                init = std::invoke(reduce, std::move(init), std::move(*partial));
+            }
+        }
+        return init;
+    }
+
+}
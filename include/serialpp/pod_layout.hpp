@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "common.hpp"
+#include "record.hpp"
+#include "scalar.hpp"
+#include "static_array.hpp"
+#include "utility.hpp"
+
+
+namespace serialpp {
+
+    /*
+        POD layout:
+            A record whose fields are all scalars (excluding bool and null), static_arrays of such, or nested records of
+            such has a serialised representation with no padding and no variable data. On little-endian platforms, that
+            representation is identical to the object representation of an equivalent plain struct, so the whole record
+            can be serialised or deserialised with a single copy.
+    */
+
+
+    // Specialising to true declares that the object representation of S is identical to the serialised representation
+    // of record R on little-endian platforms. That is, S's non-static data members correspond to R's fields, in order
+    // of declaration, with the same types (a static_array<T, Size> corresponds to T[Size] or std::array<T, Size>), and
+    // S has no padding.
+    // The parts of this which can be checked at compile time are checked by pod_layout_of.
+    template<record_type R, typename S>
+    inline constexpr bool enable_pod_layout = false;
+
+
+    namespace detail {
+
+        // Serialisable type whose serialised representation is the same as the object representation of an equivalent
+        // plain type on little-endian platforms.
+        template<typename T>
+        inline constexpr bool is_pod_layout_type = in_place_scalar<T>;
+
+        template<typename T, std::size_t Size>
+        inline constexpr bool is_pod_layout_type<static_array<T, Size>> = is_pod_layout_type<T>;
+
+        template<class Fields>
+        inline constexpr bool fields_pod_layout = false;
+
+        template<field... Fs>
+        inline constexpr bool fields_pod_layout<type_list<Fs...>> = (is_pod_layout_type<typename Fs::type> && ...);
+
+        template<record_type R>
+        inline constexpr bool is_pod_layout_type<R> = fields_pod_layout<typename R::fields>;
+
+    }
+
+
+    // Type S which has been declared to have the same layout as record R with enable_pod_layout, and which can be
+    // copied to and from R's serialised representation on this platform.
+    template<typename S, typename R>
+    concept pod_layout_of =
+        record_type<R>
+        && enable_pod_layout<R, S>
+        && detail::is_pod_layout_type<R>
+        && std::is_trivially_copyable_v<S>
+        && std::is_standard_layout_v<S>
+        && sizeof(S) == fixed_data_size_v<R>
+        && detail::is_little_endian;
+
+
+    // Serialises value as record R with a single copy, with the same result as serialise<R>(source, buffer,
+    // fixed_offset) if source held the same field values as value.
+    template<record_type R, pod_layout_of<R> S>
+    constexpr void serialise_pod(S const& value, buffer_for<R> auto&& buffer, std::size_t const fixed_offset) {
+        with_buffer_for<R>(buffer, [&value, fixed_offset](mutable_bytes_span const buffer) {
+            assert(fixed_offset <= buffer.size() && buffer.size() - fixed_offset >= sizeof(S));
+            auto const destination = buffer.subspan(fixed_offset, sizeof(S));
+            if (std::is_constant_evaluated()) {
+                // Can't memcpy at compile time.
+                auto const bytes = std::bit_cast<std::array<std::byte, sizeof(S)>>(value);
+                std::ranges::copy(bytes, destination.begin());
+            }
+            else {
+                std::memcpy(destination.data(), &value, sizeof(S));
+            }
+        });
+    }
+
+
+    // Initialises the buffer and serialises value as record R beginning from the start of the buffer, with a single
+    // copy.
+    template<record_type R, pod_layout_of<R> S>
+    constexpr void serialise_pod(S const& value, serialise_buffer auto& buffer) {
+        buffer.initialise(sizeof(S));
+        serialise_pod<R>(value, buffer, 0);
+    }
+
+
+    // Deserialises record R into output with a single copy.
+    // buffer is the full bytes buffer.
+    // fixed_offset is the index in buffer at which the record's fixed data begins.
+    // Buffer bounds checking is performed.
+    template<record_type R, pod_layout_of<R> S>
+    constexpr void deserialise_into(const_bytes_span const buffer, S& output, std::size_t const fixed_offset = 0) {
+        detail::check_buffer_size_for<R>(buffer, fixed_offset);
+        auto const source = buffer.subspan(fixed_offset, sizeof(S));
+        if (std::is_constant_evaluated()) {
+            // Can't memcpy at compile time.
+            std::array<std::byte, sizeof(S)> bytes{};
+            std::ranges::copy(source, bytes.begin());
+            output = std::bit_cast<S>(bytes);
+        }
+        else {
+            std::memcpy(&output, source.data(), sizeof(S));
+        }
+    }
+
+}
@@ -317,6 +317,21 @@ namespace serialpp {
         template<typename B, field... Fs>
         inline constexpr bool is_buffer_for_fields<B, type_list<Fs...>> = (buffer_for<B, typename Fs::type> && ...);
 
+
+        template<class Fields>
+        inline constexpr bool fields_size_precomputable = false;
+
+        template<field... Fs>
+        inline constexpr bool fields_size_precomputable<type_list<Fs...>> =
+            (size_precomputable<typename Fs::type> && ...);
+
+
+        template<class Fields>
+        inline constexpr bool fields_validatable = false;
+
+        template<field... Fs>
+        inline constexpr bool fields_validatable<type_list<Fs...>> = (validatable<typename Fs::type> && ...);
+
     }
 
 
@@ -329,6 +344,13 @@ namespace serialpp {
             }(std::make_index_sequence<R::fields::size>{});
         }
 
+        static constexpr std::size_t variable_data_size(serialise_source<R> const& source)
+                requires detail::fields_size_precomputable<typename R::fields> {
+            return [&source] <std::size_t... Is> (std::index_sequence<Is...>) {
+                return (std::size_t{0} + ... + _variable_data_size<Is>(source));
+            }(std::make_index_sequence<R::fields::size>{});
+        }
+
     private:
         template<std::size_t Index, typename B>
             requires (Index < R::fields::size) && detail::is_buffer_for_fields<B, typename R::fields>
@@ -337,6 +359,13 @@ namespace serialpp {
             fixed_offset = push_fixed_subobject<typename field::type>(fixed_offset,
                 detail::bind_serialise(source.get<field::name>(), buffer));
         }
+
+        template<std::size_t Index>
+            requires (Index < R::fields::size) && detail::fields_size_precomputable<typename R::fields>
+        static constexpr std::size_t _variable_data_size(serialise_source<R> const& source) {
+            using field = typename detail::type_list_element<typename R::fields, Index>::type;
+            return serialpp::variable_data_size<typename field::type>(source.template get<field::name>());
+        }
     };
 
 
@@ -368,14 +397,30 @@ namespace serialpp {
         template<serialisable T> requires record_derived_from<R, T>
         constexpr operator deserialiser<T>() const noexcept {
             static_assert(fixed_data_size_v<T> <= fixed_data_size_v<R>);
-            return deserialise<T>(_buffer, _fixed_offset);
+            return _deserialise<T>(_fixed_offset);
+        }
+
+        // Validates each field's subobjects.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires detail::fields_validatable<typename R::fields> {
+            [this, parallel] <std::size_t... Is> (std::index_sequence<Is...>) {
+                (_validate_subobjects<Is>(parallel), ...);
+            }(std::make_index_sequence<R::fields::size>{});
         }
 
     private:
         template<std::size_t Offset, serialisable T> requires (Offset + fixed_data_size_v<T> <= fixed_data_size_v<R>)
         [[nodiscard]]
         constexpr deserialise_t<T> _get() const {
-            return deserialise<T>(_buffer, _fixed_offset + Offset);
+            return _deserialise<T>(_fixed_offset + Offset);
+        }
+
+        template<std::size_t Index>
+            requires (Index < R::fields::size) && detail::fields_validatable<typename R::fields>
+        constexpr void _validate_subobjects(parallel_executor const* const parallel) const {
+            using field = typename detail::type_list_element<typename R::fields, Index>::type;
+            constexpr auto offset = detail::named_field_offset<typename R::fields, field::name>();
+            detail::validate_subobjects<typename field::type>(_buffer, _fixed_offset + offset, parallel);
         }
     };
 
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <compare>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <type_traits>
 
 #include "common.hpp"
@@ -323,10 +329,10 @@ namespace serialpp {
             //  - the fixed width integer types have no padding bits
             //  - we know F is IEEE-754 binary format, which has no padding bits
             if constexpr (sizeof(F) == 4) {
-                return std::bit_cast<F>(deserialise<std::uint32_t>(_buffer, _fixed_offset));
+                return std::bit_cast<F>(_deserialise<std::uint32_t>(_fixed_offset));
             }
             else if constexpr (sizeof(F) == 8) {
-                return std::bit_cast<F>(deserialise<std::uint64_t>(_buffer, _fixed_offset));
+                return std::bit_cast<F>(_deserialise<std::uint64_t>(_fixed_offset));
             }
             else {
                 // Unreachable.
@@ -335,4 +341,165 @@ namespace serialpp {
         }
     };
 
+
+
+    namespace detail {
+
+        // Scalar whose serialised representation is the same as its object representation on little-endian platforms,
+        // and so can be accessed in-place within a buffer.
+        // Excludes bool (since any nonzero byte deserialises to true) and null (which has no representation).
+        template<typename T>
+        concept in_place_scalar = scalar<T> && !std::same_as<T, bool> && !std::same_as<T, null>;
+
+
+        // Gets a view of count consecutive instances of S starting at the specified offset, which directly references
+        // buffer. Returns an empty std::optional if the platform isn't little-endian, if the instances aren't suitably
+        // aligned within buffer, or during constant evaluation.
+        // Throws buffer_bounds_error if buffer is too small to contain the instances.
+        // No S objects were ever created in the buffer. Where the standard library provides it,
+        // std::start_lifetime_as_array() starts their lifetimes in place, making the view well-defined. Otherwise, the
+        // bytes are reinterpreted as S, which relies on the compiler treating them as implicitly created S objects.
+        // All major compilers do so for scalars, but the Standard doesn't guarantee it.
+        template<in_place_scalar S>
+        [[nodiscard]]
+        constexpr std::optional<std::span<S const>> in_place_scalars(const_bytes_span const buffer,
+                std::size_t const offset, std::size_t const count) {
+            check_buffer_size_for_elements<S>(buffer, offset, count);
+            if (std::is_constant_evaluated() || !is_little_endian) {
+                return std::nullopt;
+            }
+            else {
+                auto const data = buffer.data() + offset;
+                if (reinterpret_cast<std::uintptr_t>(data) % alignof(S) == 0) {
+#if defined(__cpp_lib_start_lifetime_as) && __cpp_lib_start_lifetime_as >= 202207L
+                    return std::span{std::start_lifetime_as_array<S const>(data, count), count};
+#else
+                    return std::span{reinterpret_cast<S const*>(data), count};
+#endif
+                }
+                else {
+                    return std::nullopt;
+                }
+            }
+        }
+
+
+        // Scalar S which can be converted to U without narrowing, e.g. std::uint16_t to std::uint32_t.
+        template<typename S, typename U>
+        concept scalar_convertible_to = scalar<S> && requires(S const value) {
+            U{value};
+        };
+
+
+        // Reverses the byte order of an unsigned integer, like C++23's std::byteswap().
+        template<std::unsigned_integral U>
+        [[nodiscard]]
+        constexpr U byte_swap(U value) noexcept {
+            U result = 0;
+            for (std::size_t i = 0; i < sizeof(U); ++i) {
+                result = static_cast<U>((result << 8) | (value & 0xFFu));
+                value = static_cast<U>(value >> 8);
+            }
+            return result;
+        }
+
+
+        // Deserialises output.size() consecutive instances of S starting at the specified offset into output,
+        // converting each to U.
+        // Uses bulk copies where possible, which is much faster than deserialising each element individually.
+        // Throws buffer_bounds_error if buffer is too small to contain the instances.
+        template<scalar S, typename U, std::size_t Extent> requires scalar_convertible_to<S, U>
+        constexpr void deserialise_scalars(const_bytes_span const buffer, std::size_t offset,
+                std::span<U, Extent> const output) {
+            check_buffer_size_for_elements<S>(buffer, offset, output.size());
+            if constexpr (in_place_scalar<S>) {
+                if (!std::is_constant_evaluated() && !is_mixed_endian) {
+                    auto const source = buffer.data() + offset;
+                    if constexpr (std::same_as<S, U> && (is_little_endian || sizeof(S) == 1)) {
+                        if (!output.empty()) {
+                            std::memcpy(output.data(), source, output.size() * sizeof(S));
+                        }
+                    }
+                    else {
+                        // Copy chunks into an aligned temporary, then byte swap and convert. Simple enough for
+                        // compilers to vectorise.
+                        using uint_type = std::conditional_t<sizeof(S) == 1, std::uint8_t,
+                            std::conditional_t<sizeof(S) == 2, std::uint16_t,
+                            std::conditional_t<sizeof(S) == 4, std::uint32_t, std::uint64_t>>>;
+                        static_assert(sizeof(uint_type) == sizeof(S));
+                        constexpr std::size_t chunk_size = 1024 / sizeof(S);
+                        std::array<S, chunk_size> chunk;
+                        for (std::size_t begin = 0; begin < output.size(); begin += chunk_size) {
+                            auto const count = std::min(chunk_size, output.size() - begin);
+                            std::memcpy(chunk.data(), source + begin * sizeof(S), count * sizeof(S));
+                            if constexpr (is_big_endian && sizeof(S) > 1) {
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    chunk[i] = std::bit_cast<S>(byte_swap(std::bit_cast<uint_type>(chunk[i])));
+                                }
+                            }
+                            for (std::size_t i = 0; i < count; ++i) {
+                                output[begin + i] = U{chunk[i]};
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            // Mixed endianness, or constexpr (can't reinterpret_cast at compile time).
+            for (U& element : output) {
+                element = U{deserialiser<S>{buffer, offset}.value()};
+                offset += fixed_data_size_v<S>;
+            }
+        }
+
+
+        // Contiguous range of S or serialise_source<S>, which have the same object representation.
+        template<typename R, typename S>
+        concept contiguous_scalar_range =
+            in_place_scalar<S> && std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+            && (std::same_as<std::ranges::range_value_t<R>, S>
+                || std::same_as<std::ranges::range_value_t<R>, serialise_source<S>>);
+
+
+        // Serialises the elements contiguously into buffer beginning at fixed_offset, with the same result as
+        // serialising each element with serialiser<S>, but using a single bulk copy where possible.
+        // The caller must ensure (fixed_offset + std::ranges::size(elements) * fixed_data_size_v<S>) <= buffer.size()
+        template<in_place_scalar S, contiguous_scalar_range<S> R>
+        constexpr void serialise_scalars(R const& elements, mutable_bytes_span const buffer,
+                std::size_t fixed_offset) {
+            static_assert(sizeof(std::ranges::range_value_t<R>) == sizeof(S));
+            static_assert(fixed_data_size_v<S> == sizeof(S));
+
+            if (std::is_constant_evaluated() || is_mixed_endian) {
+                // Mixed endianness, or constexpr (can't reinterpret_cast at compile time).
+                for (S const element : elements) {
+                    serialiser<S>::serialise(element, buffer, fixed_offset);
+                    fixed_offset += sizeof(S);
+                }
+            }
+            else {
+                auto const count = std::ranges::size(elements);
+                auto const destination = buffer.subspan(fixed_offset, count * sizeof(S)).data();
+                auto const source = std::ranges::data(elements);
+                if constexpr (is_little_endian || sizeof(S) == 1) {
+                    // An empty range may have a null data pointer, which memcpy doesn't allow.
+                    if (count > 0) {
+                        std::memcpy(destination, source, count * sizeof(S));
+                    }
+                }
+                else if constexpr (is_big_endian) {
+                    // Simple enough for compilers to vectorise.
+                    using uint_type = std::conditional_t<sizeof(S) == 2, std::uint16_t,
+                        std::conditional_t<sizeof(S) == 4, std::uint32_t, std::uint64_t>>;
+                    static_assert(sizeof(uint_type) == sizeof(S));
+                    for (std::size_t i = 0; i < count; ++i) {
+                        auto const value = byte_swap(std::bit_cast<uint_type>(static_cast<S>(source[i])));
+                        std::memcpy(destination + i * sizeof(S), &value, sizeof(S));
+                    }
+                }
+            }
+        }
+
+    }
+
 }
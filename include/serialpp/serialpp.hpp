@@ -1,12 +1,20 @@
 #pragma once
 
+#include "bitset.hpp"
 #include "buffers.hpp"
 #include "common.hpp"
+#include "dedup_buffer.hpp"
+#include "delta_array.hpp"
 #include "dynamic_array.hpp"
+#include "hash_map.hpp"
 #include "optional.hpp"
 #include "pair.hpp"
+#include "pod_layout.hpp"
 #include "record.hpp"
 #include "scalar.hpp"
+#include "sorted_map.hpp"
 #include "static_array.hpp"
+#include "string.hpp"
 #include "tuple.hpp"
 #include "variant.hpp"
+#include "varint.hpp"
@@ -0,0 +1,514 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+#include "dynamic_array.hpp"
+#include "scalar.hpp"
+#include "utility.hpp"
+
+
+namespace serialpp {
+
+    /*
+        sorted_map:
+            Fixed data is an entry count (Format::size_type), then a keys offset (Format::offset_type), then a values
+            offset (Format::offset_type).
+            If the entry count is > 0, then the keys' fixed data is contained contiguously starting at the keys offset,
+            in strictly increasing order according to Compare, and the corresponding values' fixed data is contained
+            contiguously starting at the values offset (i.e. each is laid out like the elements of a dynamic_array).
+            If the entry count is 0, then the offsets are not significant and no variable data is present.
+    */
+
+
+    // Serialisable associative container which maps unique keys of type K to values of type V. Can hold up to
+    // basic_max_dynamic_array_size<Format> entries.
+    // Entries are sorted by key when serialised, and the keys are stored separately from the values, so lookups are
+    // done by binary search directly on the buffer, touching only keys.
+    // Compare must be default constructible, and must be a strict weak ordering over both serialise_source<K> (used to
+    // sort) and deserialise_t<K> (used to search), which must be consistent with each other.
+    // Format determines the size of the entry count and offsets (see format_profile).
+    template<serialisable K, serialisable V, typename Compare = std::less<>, format_profile Format = compact_format>
+    struct sorted_map {
+        using key_type = K;
+        using mapped_type = V;
+        using key_compare = Compare;
+        using format = Format;
+    };
+
+    // sorted_map which can hold more than 2^32 - 1 entries, and refer to variable data anywhere in a buffer larger than
+    // 4 GiB.
+    template<serialisable K, serialisable V, typename Compare = std::less<>>
+    using large_sorted_map = sorted_map<K, V, Compare, large_format>;
+
+
+    template<serialisable K, serialisable V, typename Compare, format_profile Format>
+    struct fixed_data_size<sorted_map<K, V, Compare, Format>> : detail::size_t_constant<
+        fixed_data_size_v<typename Format::size_type> + 2 * fixed_data_size_v<typename Format::offset_type>> {};
+
+
+    // Holds the entries by value. Constructible from a braced-init-list of entries, a std::vector of entries, or any
+    // range of pair-like objects convertible to entries (e.g. a std::map or std::unordered_map).
+    // The entries are sorted by key on construction. Throws std::invalid_argument if any keys are equivalent.
+    template<serialisable K, serialisable V, typename Compare, format_profile Format>
+    class serialise_source<sorted_map<K, V, Compare, Format>> {
+    public:
+        using entry_type = std::pair<serialise_source<K>, serialise_source<V>>;
+
+        // Constructs with zero entries.
+        constexpr serialise_source() = default;
+
+        // Constructs from the entries of a braced-init-list.
+        template<std::size_t N>
+        constexpr serialise_source(entry_type (&& entries)[N]) {
+            _entries.reserve(N);
+            for (auto& entry : entries) {
+                _entries.push_back(std::move(entry));
+            }
+            _sort();
+        }
+
+        // Takes ownership of the entries without copying them.
+        // (A template so that a braced-init-list is never implicitly converted to std::vector.)
+        template<std::same_as<std::vector<entry_type>> Vector>
+        constexpr serialise_source(Vector&& entries) :
+            _entries{std::move(entries)}
+        {
+            _sort();
+        }
+
+        template<std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, entry_type>
+                && (!std::same_as<R, std::vector<entry_type>>)
+        constexpr serialise_source(R&& entries) {
+            if constexpr (std::ranges::sized_range<R>) {
+                _entries.reserve(std::ranges::size(entries));
+            }
+            for (auto&& entry : entries) {
+                _entries.emplace_back(std::forward<decltype(entry)>(entry));
+            }
+            _sort();
+        }
+
+        // Gets the number of entries.
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _entries.size();
+        }
+
+        // Gets a view of the keys, in sorted order.
+        [[nodiscard]]
+        constexpr auto keys() const {
+            return _sorted | std::views::transform([this](std::size_t const index) -> serialise_source<K> const& {
+                return _entries[index].first;
+            });
+        }
+
+        // Gets a view of the values, in key order.
+        [[nodiscard]]
+        constexpr auto values() const {
+            return _sorted | std::views::transform([this](std::size_t const index) -> serialise_source<V> const& {
+                return _entries[index].second;
+            });
+        }
+
+    private:
+        std::vector<entry_type> _entries;
+        // Indices of the entries, sorted by key. Entries are sorted indirectly since serialise_sources need not be
+        // assignable.
+        std::vector<std::size_t> _sorted;
+
+        constexpr void _sort() {
+            _sorted.resize(_entries.size());
+            std::iota(_sorted.begin(), _sorted.end(), std::size_t{0});
+            auto const compare_keys = [this](std::size_t const lhs, std::size_t const rhs) {
+                return static_cast<bool>(Compare{}(_entries[lhs].first, _entries[rhs].first));
+            };
+            std::ranges::sort(_sorted, compare_keys);
+            if (std::ranges::adjacent_find(_sorted, std::not_fn(compare_keys)) != _sorted.end()) {
+                throw std::invalid_argument{"sorted_map keys must be unique"};
+            }
+        }
+    };
+
+
+    template<serialisable K, serialisable V, typename Compare, format_profile Format>
+    struct serialiser<sorted_map<K, V, Compare, Format>> {
+        static constexpr void serialise(serialise_source<sorted_map<K, V, Compare, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            using size_type = Format::size_type;
+            using offset_type = Format::offset_type;
+
+            auto const size = source.size();
+            auto const count = detail::to_dynamic_array_size<Format>(size);
+            offset_type keys_offset = 0;
+            offset_type values_offset = 0;
+            if (size > 0) {
+                auto keys = source.keys();
+                keys_offset = detail::to_data_offset<offset_type>(
+                    detail::serialise_dynamic_array_elements<K>(keys, size, buffer, nullptr));
+                auto values = source.values();
+                values_offset = detail::to_data_offset<offset_type>(
+                    detail::serialise_dynamic_array_elements<V>(values, size, buffer, nullptr));
+            }
+
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<size_type>{count}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{keys_offset}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{values_offset}, buffer));
+        }
+
+        static constexpr std::size_t variable_data_size(
+                serialise_source<sorted_map<K, V, Compare, Format>> const& source)
+                requires size_precomputable<K> && size_precomputable<V> {
+            auto keys = source.keys();
+            auto values = source.values();
+            return detail::dynamic_array_elements_size<K>(keys, source.size())
+                + detail::dynamic_array_elements_size<V>(values, source.size());
+        }
+    };
+
+
+    // Random-access view of the entries of a serialised sorted_map, in key order, obtained from
+    // deserialiser<sorted_map<K, V, Compare, Format>>::entries().
+    // Each entry is a std::pair of deserialise_t<K> and deserialise_t<V>.
+    // References only the buffer, so may outlive the deserialiser it was obtained from. Likewise, iterators (including
+    // those returned by lower_bound(), upper_bound() and find()) may outlive the view.
+    template<serialisable K, serialisable V, typename Compare = std::less<>>
+    class sorted_map_view : public std::ranges::view_interface<sorted_map_view<K, V, Compare>> {
+    public:
+        using value_type = std::pair<deserialise_t<K>, deserialise_t<V>>;
+
+        class iterator {
+        public:
+            using value_type = sorted_map_view::value_type;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            iterator() = default;
+
+            [[nodiscard]]
+            constexpr value_type operator*() const {
+                return {key(), value()};
+            }
+
+            [[nodiscard]]
+            constexpr value_type operator[](difference_type const n) const {
+                return *(*this + n);
+            }
+
+            // Gets the key of the entry, without deserialising the value.
+            [[nodiscard]]
+            constexpr deserialise_t<K> key() const {
+                return _keys[static_cast<std::size_t>(_index)];
+            }
+
+            // Gets the value of the entry, without deserialising the key.
+            [[nodiscard]]
+            constexpr deserialise_t<V> value() const {
+                return _values[static_cast<std::size_t>(_index)];
+            }
+
+            constexpr iterator& operator++() noexcept {
+                ++_index;
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept {
+                auto const old = *this;
+                ++*this;
+                return old;
+            }
+
+            constexpr iterator& operator--() noexcept {
+                --_index;
+                return *this;
+            }
+
+            constexpr iterator operator--(int) noexcept {
+                auto const old = *this;
+                --*this;
+                return old;
+            }
+
+            constexpr iterator& operator+=(difference_type const n) noexcept {
+                _index += n;
+                return *this;
+            }
+
+            constexpr iterator& operator-=(difference_type const n) noexcept {
+                return *this += -n;
+            }
+
+            [[nodiscard]]
+            friend constexpr iterator operator+(iterator it, difference_type const n) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend constexpr iterator operator+(difference_type const n, iterator it) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend constexpr iterator operator-(iterator it, difference_type const n) noexcept {
+                return it -= n;
+            }
+
+            [[nodiscard]]
+            friend constexpr difference_type operator-(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index - rhs._index;
+            }
+
+            [[nodiscard]]
+            friend constexpr bool operator==(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index == rhs._index;
+            }
+
+            [[nodiscard]]
+            friend constexpr std::strong_ordering operator<=>(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index <=> rhs._index;
+            }
+
+        private:
+            friend class sorted_map_view;
+
+            // Copies of the view's key and value views, which reference only the buffer, so the iterator remains valid
+            // after the view is destroyed.
+            dynamic_array_view<K> _keys;
+            dynamic_array_view<V> _values;
+            difference_type _index = 0;
+
+            constexpr iterator(sorted_map_view const& view, std::size_t const index) noexcept :
+                _keys{view._keys}, _values{view._values}, _index{static_cast<difference_type>(index)}
+            {}
+        };
+
+        sorted_map_view() = default;
+
+        constexpr sorted_map_view(dynamic_array_view<K> const keys, dynamic_array_view<V> const values) noexcept :
+            _keys{keys}, _values{values}
+        {
+            assert(keys.size() == values.size());
+        }
+
+        [[nodiscard]]
+        constexpr iterator begin() const noexcept {
+            return iterator{*this, 0};
+        }
+
+        [[nodiscard]]
+        constexpr iterator end() const noexcept {
+            return iterator{*this, size()};
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _keys.size();
+        }
+
+        // Gets a view of the keys, in order.
+        [[nodiscard]]
+        constexpr dynamic_array_view<K> keys() const noexcept {
+            return _keys;
+        }
+
+        // Gets a view of the values, in key order.
+        [[nodiscard]]
+        constexpr dynamic_array_view<V> values() const noexcept {
+            return _values;
+        }
+
+        // Gets an iterator to the first entry whose key is not less than key, or end() if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr iterator lower_bound(Key const& key) const {
+            return iterator{*this, _partition_point([&key](deserialise_t<K> const& element) {
+                return static_cast<bool>(Compare{}(element, key));
+            })};
+        }
+
+        // Gets an iterator to the first entry whose key is greater than key, or end() if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr iterator upper_bound(Key const& key) const {
+            return iterator{*this, _partition_point([&key](deserialise_t<K> const& element) {
+                return !static_cast<bool>(Compare{}(key, element));
+            })};
+        }
+
+        // Gets an iterator to the entry whose key is equivalent to key, or end() if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr iterator find(Key const& key) const {
+            auto const it = lower_bound(key);
+            if (it != end() && !static_cast<bool>(Compare{}(key, it.key()))) {
+                return it;
+            }
+            else {
+                return end();
+            }
+        }
+
+        // Checks if there is an entry whose key is equivalent to key.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr bool contains(Key const& key) const {
+            return find(key) != end();
+        }
+
+    private:
+        dynamic_array_view<K> _keys;
+        dynamic_array_view<V> _values;
+
+        // Gets the index of the first key for which predicate is false. predicate must be true for a prefix of keys.
+        template<typename P>
+        [[nodiscard]]
+        constexpr std::size_t _partition_point(P const& predicate) const {
+            std::size_t first = 0;
+            auto count = _keys.size();
+            while (count > 0) {
+                auto const half = count / 2;
+                if (predicate(_keys[first + half])) {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+    };
+
+
+    template<serialisable K, serialisable V, typename Compare, format_profile Format>
+    class deserialiser<sorted_map<K, V, Compare, Format>> : public deserialiser_base {
+    public:
+        using deserialiser_base::deserialiser_base;
+
+        // Gets the number of entries.
+        [[nodiscard]]
+        constexpr std::size_t size() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
+        }
+
+        // Checks if there are zero entries.
+        [[nodiscard]]
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        // Gets a random-access view of the entries, in key order, which supports lookups with lower_bound(),
+        // upper_bound() and find().
+        // Throws buffer_bounds_error if any key or value is out of bounds.
+        [[nodiscard]]
+        constexpr sorted_map_view<K, V, Compare> entries() const {
+            auto const size = this->size();
+            return sorted_map_view<K, V, Compare>{_elements<K>(size, 0), _elements<V>(size, 1)};
+        }
+
+        // Gets the value whose key is equivalent to key, or an empty std::optional if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr std::optional<deserialise_t<V>> find(Key const& key) const {
+            auto const entries = this->entries();
+            if (auto const it = entries.find(key); it != entries.end()) {
+                return it.value();
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+
+        // Checks if there is an entry whose key is equivalent to key.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr bool contains(Key const& key) const {
+            return entries().contains(key);
+        }
+
+        // Gets the value whose key is equivalent to key. Throws std::out_of_range if there is none.
+        template<typename Key>
+        [[nodiscard]]
+        constexpr deserialise_t<V> at(Key const& key) const {
+            if (auto value = find(key)) {
+                return *std::move(value);
+            }
+            else {
+                throw std::out_of_range{"key not found in sorted_map"};
+            }
+        }
+
+        // Checks that all keys and values are within the buffer, validates each key's and value's subobjects, and
+        // checks that the keys are in strictly increasing order.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires validatable<K> && validatable<V> {
+            auto const size = this->size();
+            if (size > 0) {
+                _validate_elements<K>(size, 0, parallel);
+                _validate_elements<V>(size, 1, parallel);
+
+                auto const keys = entries().keys();
+                for (std::size_t i = 1; i < size; ++i) {
+                    if (!static_cast<bool>(Compare{}(keys[i - 1], keys[i]))) {
+                        throw invalid_value_error{
+                            std::format("sorted_map key at index {} is not greater than the previous key", i)};
+                    }
+                }
+            }
+        }
+
+    private:
+        // Gets the keys' (offset_index 0) or values' (offset_index 1) offset.
+        [[nodiscard]]
+        constexpr std::size_t _offset(std::size_t const offset_index) const {
+            auto const offset_offset = _fixed_offset + fixed_data_size_v<typename Format::size_type>
+                + fixed_data_size_v<typename Format::offset_type> * offset_index;
+            return static_cast<std::size_t>(_deserialise<typename Format::offset_type>(offset_offset));
+        }
+
+        template<serialisable T>
+        [[nodiscard]]
+        constexpr dynamic_array_view<T> _elements(std::size_t const size, std::size_t const offset_index) const {
+            return dynamic_array_view<T>{_buffer, size > 0 ? _offset(offset_index) : 0, size, _checked};
+        }
+
+        template<serialisable T>
+        constexpr void _validate_elements(std::size_t const size, std::size_t const offset_index,
+                parallel_executor const* const parallel) const {
+            auto const offset = _offset(offset_index);
+            detail::check_buffer_size_for_elements<T>(_buffer, offset, size);
+            if constexpr (!fixed_size_serialisable<T>) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    detail::validate_subobjects<T>(_buffer, offset + fixed_data_size_v<T> * i, parallel);
+                }
+            }
+        }
+    };
+
+}
+
+
+namespace std::ranges {
+
+    // Iterators of sorted_map_view reference only the buffer, so they may outlive the view.
+    template<::serialpp::serialisable K, ::serialpp::serialisable V, typename Compare>
+    inline constexpr bool enable_borrowed_range<::serialpp::sorted_map_view<K, V, Compare>> = true;
+
+}
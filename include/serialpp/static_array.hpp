@@ -1,14 +1,18 @@
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <format>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
 
 #include "common.hpp"
+#include "scalar.hpp"
 #include "utility.hpp"
 
 
@@ -59,6 +63,17 @@ namespace serialpp {
             _serialise(source, buffer, fixed_offset);
         }
 
+        static constexpr std::size_t variable_data_size(serialise_source<static_array<T, Size>> const& source)
+                requires size_precomputable<T> {
+            std::size_t size = 0;
+            if constexpr (Size > 0) {
+                for (auto const& element : source.elements) {
+                    size += serialpp::variable_data_size<T>(element);
+                }
+            }
+            return size;
+        }
+
     private:
         static constexpr void _serialise(serialise_source<static_array<T, Size>> const& source, auto&& buffer,
                 std::size_t fixed_offset) {
@@ -85,7 +100,7 @@ namespace serialpp {
         [[nodiscard]]
         constexpr deserialise_t<T> operator[](std::size_t const index) const {
             assert(index < Size);
-            return deserialise<T>(_buffer, _fixed_offset + index * fixed_data_size_v<T>);
+            return _deserialise<T>(_fixed_offset + index * fixed_data_size_v<T>);
         }
 
         // Gets the element at the specified index. Throws std::out_of_range if index is out of bounds.
@@ -116,6 +131,63 @@ namespace serialpp {
                     return (*this)[index];
                 });
         }
+
+        // Gets a contiguous view of the elements which directly references the buffer, avoiding any copying.
+        // This is only possible on little-endian platforms, and if the elements are suitably aligned within the buffer.
+        // Otherwise, returns an empty std::optional.
+        [[nodiscard]]
+        constexpr std::optional<std::span<T const, Size>> elements_span() const requires detail::in_place_scalar<T> {
+            if (auto const span = detail::in_place_scalars<T>(_buffer, _fixed_offset, Size)) {
+                return span->template first<Size>();
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+
+        // Like elements_span(), but if the elements can't be viewed in-place, they are deserialised into
+        // fallback_storage, and a view of fallback_storage is returned instead.
+        [[nodiscard]]
+        constexpr std::span<T const, Size> elements_span(std::array<T, Size>& fallback_storage) const
+                requires detail::in_place_scalar<T> {
+            if (auto const span = elements_span()) {
+                return *span;
+            }
+            else {
+                detail::deserialise_scalars<T>(_buffer, _fixed_offset, std::span{fallback_storage});
+                return fallback_storage;
+            }
+        }
+
+        // Deserialises all elements into output and returns the part written. Throws std::out_of_range if too small.
+        template<typename U, std::size_t Extent>
+            requires detail::scalar_convertible_to<T, U> && (Extent == std::dynamic_extent || Extent >= Size)
+        constexpr std::span<U, Size> copy_to(std::span<U, Extent> const output) const {
+            if (output.size() < Size) {
+                throw std::out_of_range{
+                    std::format("output of size {} is too small for static_array with size {}", output.size(), Size)};
+            }
+            auto const written = output.template first<Size>();
+            detail::deserialise_scalars<T>(_buffer, _fixed_offset, written);
+            return written;
+        }
+
+        // Deserialises all elements into a new std::array, converting each to U (which must not narrow).
+        template<typename U = T> requires detail::scalar_convertible_to<T, U>
+        [[nodiscard]]
+        constexpr std::array<U, Size> to_array() const {
+            std::array<U, Size> result{};
+            (void)copy_to(std::span{result});
+            return result;
+        }
+
+        // Validates each element's subobjects.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires validatable<T> {
+            for (std::size_t i = 0; i < Size; ++i) {
+                detail::validate_subobjects<T>(_buffer, _fixed_offset + fixed_data_size_v<T> * i, parallel);
+            }
+        }
     };
 
 }
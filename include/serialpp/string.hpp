@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "common.hpp"
+#include "dynamic_array.hpp"
+#include "hash_map.hpp"
+#include "scalar.hpp"
+
+
+namespace serialpp {
+
+    /*
+        string:
+            Same representation as dynamic_array<char, Format>, i.e. fixed data is a character count
+            (Format::size_type) and an offset (Format::offset_type).
+            If the character count is > 0, then the characters are contained contiguously starting at the offset.
+            If the character count is 0, then the offset is not significant and no variable data is present.
+            The characters have no particular encoding and are not null-terminated.
+    */
+
+
+    // Serialisable sequence of characters, which is deserialised to a std::string_view directly into the buffer.
+    // Can hold up to basic_max_dynamic_array_size<Format> characters.
+    // Format determines the size of the character count and offset (see format_profile).
+    template<format_profile Format = compact_format>
+    struct string {
+        using format = Format;
+    };
+
+    // string which can hold more than 2^32 - 1 characters, and refer to variable data anywhere in a buffer larger than
+    // 4 GiB.
+    using large_string = string<large_format>;
+
+
+    template<format_profile Format>
+    struct fixed_data_size<string<Format>> : fixed_data_size<dynamic_array<char, Format>> {};
+
+
+    template<format_profile Format>
+    inline constexpr bool enable_auto_deserialise<string<Format>> = true;
+
+
+    // References the characters, which must outlive this object. Constructible from anything which std::string_view is
+    // (e.g. string literals and std::string).
+    template<format_profile Format>
+    class serialise_source<string<Format>> : public std::string_view {
+    public:
+        using std::string_view::basic_string_view;
+
+        template<typename S> requires std::convertible_to<S const&, std::string_view>
+        constexpr serialise_source(S const& chars) :
+            std::string_view{chars}
+        {}
+
+        // Would reference a temporary.
+        serialise_source(std::string&&) = delete;
+    };
+
+
+    template<format_profile Format>
+    struct serialiser<string<Format>> {
+        static constexpr void serialise(serialise_source<string<Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t const fixed_offset) {
+            auto const size = source.size();
+            std::size_t chars_offset = 0;
+            if (size > 0) {
+                // Check the size before extending the buffer.
+                (void)detail::to_size_type<Format>(size, "string length");
+                chars_offset = push_variable_subobjects<char>(size, buffer,
+                    [&buffer, &source, size](std::size_t const offset) {
+                        auto const output = buffer.span().subspan(offset, size);
+                        if (std::is_constant_evaluated()) {
+                            std::ranges::transform(source, output.begin(),
+                                [](char const c) { return static_cast<std::byte>(c); });
+                        }
+                        else {
+                            std::memcpy(output.data(), source.data(), size);
+                        }
+                    });
+            }
+            detail::serialise_dynamic_array_fixed_data<Format>(buffer, fixed_offset, size, chars_offset);
+        }
+
+        static constexpr std::size_t variable_data_size(serialise_source<string<Format>> const& source) noexcept {
+            return source.size();
+        }
+    };
+
+
+    template<format_profile Format>
+    class deserialiser<string<Format>> : public deserialiser_base {
+    public:
+        using deserialiser_base::deserialiser_base;
+
+        // Gets the number of characters.
+        [[nodiscard]]
+        constexpr std::size_t size() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
+        }
+
+        // Checks if there are zero characters.
+        [[nodiscard]]
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        // Gets a view of the characters, which directly references the buffer.
+        // Throws buffer_bounds_error if the characters are out of bounds.
+        [[nodiscard]]
+        std::string_view value() const {
+            auto const size = this->size();
+            if (size == 0) {
+                return {};
+            }
+            auto const offset = _offset();
+            if (_checked) {
+                detail::check_buffer_size_for_elements<char>(_buffer, offset, size);
+            }
+            return {reinterpret_cast<char const*>(_buffer.data() + offset), size};
+        }
+
+        // Checks that the characters are within the buffer.
+        constexpr void validate_subobjects(parallel_executor const* = nullptr) const {
+            if (auto const size = this->size(); size > 0) {
+                detail::check_buffer_size_for_elements<char>(_buffer, _offset(), size);
+            }
+        }
+
+    private:
+        [[nodiscard]]
+        constexpr std::size_t _offset() const {
+            auto const offset_offset = _fixed_offset + fixed_data_size_v<typename Format::size_type>;
+            return static_cast<std::size_t>(_deserialise<typename Format::offset_type>(offset_offset));
+        }
+    };
+
+
+    namespace detail {
+
+        // Stable hash of a sequence of characters, processed 8 at a time.
+        [[nodiscard]]
+        constexpr std::uint64_t hash_chars(std::string_view const chars) noexcept {
+            auto hash = mix_hash(chars.size());
+            for (std::size_t i = 0; i < chars.size(); i += 8) {
+                std::uint64_t word = 0;
+                auto const end = std::min(i + 8, chars.size());
+                for (auto j = i; j < end; ++j) {
+                    word |= static_cast<std::uint64_t>(static_cast<unsigned char>(chars[j])) << ((j - i) * 8);
+                }
+                hash = mix_hash(hash ^ word);
+            }
+            return hash;
+        }
+
+    }
+
+
+    // Hashes the characters, so lookups may use any type convertible to std::string_view.
+    template<format_profile Format>
+    struct stable_hash<string<Format>> {
+        [[nodiscard]]
+        constexpr std::uint64_t operator()(std::string_view const key) const noexcept {
+            return detail::hash_chars(key);
+        }
+    };
+
+}
@@ -53,6 +53,13 @@ namespace serialpp {
             }(std::make_index_sequence<sizeof...(Ts)>{});
         }
 
+        static constexpr std::size_t variable_data_size(serialise_source<tuple<Ts...>> const& source)
+                requires (size_precomputable<Ts> && ...) {
+            return [&source] <std::size_t... Is> (std::index_sequence<Is...>) {
+                return (std::size_t{0} + ... + serialpp::variable_data_size<Ts>(std::get<Is>(source)));
+            }(std::make_index_sequence<sizeof...(Ts)>{});
+        }
+
     private:
         template<std::size_t Index, typename B> requires (Index < sizeof...(Ts)) && (buffer_for<B, Ts> && ...)
         static constexpr void _serialise(serialise_source<tuple<Ts...>> const& source, B&& buffer,
@@ -88,7 +95,16 @@ namespace serialpp {
         constexpr auto get() const {
             constexpr auto offset = detail::tuple_element_offset<type_list<Ts...>, Index>;
             using element_type = detail::type_list_element<type_list<Ts...>, Index>::type;
-            return deserialise<element_type>(_buffer, _fixed_offset + offset);
+            return _deserialise<element_type>(_fixed_offset + offset);
+        }
+
+        // Validates each element's subobjects.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires (validatable<Ts> && ...) {
+            [this, parallel] <std::size_t... Is> (std::index_sequence<Is...>) {
+                (detail::validate_subobjects<Ts>(
+                    _buffer, _fixed_offset + detail::tuple_element_offset<type_list<Ts...>, Is>, parallel), ...);
+            }(std::index_sequence_for<Ts...>{});
         }
     };
 
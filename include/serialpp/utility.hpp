@@ -6,11 +6,15 @@
 #include <concepts>
 #include <cstddef>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <new>
+#include <span>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
 
 
 namespace serialpp {
@@ -110,7 +114,9 @@ namespace serialpp {
 
 
         // Saddeningly, this isn't in the Standard Library yet.
-        template<typename T> requires std::is_object_v<T>
+        // Deleter must be stateless.
+        template<typename T, typename Deleter = std::default_delete<T>>
+            requires std::is_object_v<T> && std::is_empty_v<Deleter> && std::default_initializable<Deleter>
         class constexpr_unique_ptr {
         public:
             using pointer = std::remove_extent_t<T>*;
@@ -176,7 +182,7 @@ namespace serialpp {
 
             constexpr void _delete() noexcept {
                 if (_pointer) {
-                    std::default_delete<T>{}(_pointer);
+                    Deleter{}(_pointer);
                 }
             }
         };
@@ -292,6 +298,40 @@ namespace serialpp {
             }
         };
 
+
+        // Either references or owns a contiguous sequence of T.
+        template<typename T>
+        class maybe_owned_span {
+        public:
+            // Constructs empty.
+            constexpr maybe_owned_span() = default;
+
+            // Owns a copy of the elements of a braced-init-list.
+            constexpr maybe_owned_span(std::initializer_list<T> const elements) :
+                _elements{std::in_place_type<std::vector<T>>, elements}
+            {}
+
+            // Takes ownership of the elements of a vector.
+            constexpr maybe_owned_span(std::vector<T>&& elements) noexcept :
+                _elements{std::in_place_type<std::vector<T>>, std::move(elements)}
+            {}
+
+            // References elements, which must outlive this object.
+            constexpr maybe_owned_span(std::span<T const> const elements) noexcept :
+                _elements{std::in_place_type<std::span<T const>>, elements}
+            {}
+
+            [[nodiscard]]
+            constexpr std::span<T const> get() const noexcept {
+                return std::visit([](auto const& elements) {
+                    return std::span<T const>{elements};
+                }, _elements);
+            }
+
+        private:
+            std::variant<std::span<T const>, std::vector<T>> _elements;
+        };
+
     }
 
 }
@@ -4,6 +4,7 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <format>
 #include <functional>
 #include <limits>
 #include <type_traits>
@@ -22,7 +23,7 @@ namespace serialpp {
     /*
         variant:
             Fixed data is a type index (variant_index_t) indicating which type is contained, and an offset to the
-            variable data (data_offset_t).
+            variable data (Format::offset_type).
             Variable data is the contained value.
 
             If the set of possible types is empty, then the type index and offset are not significant.
@@ -36,37 +37,48 @@ namespace serialpp {
 
     // Serialisable type that holds exactly one instance of a type from a set of possible types.
     // Can have up to max_variant_types types (including zero).
-    template<serialisable... Ts> requires (sizeof...(Ts) <= max_variant_types)
-    struct variant {
+    // Format determines the size of the offset (see format_profile).
+    template<format_profile Format, serialisable... Ts> requires (sizeof...(Ts) <= max_variant_types)
+    struct basic_variant {
         using index_type = variant_index_t;
+        using format = Format;
 
         using types = type_list<Ts...>;
     };
 
+    template<serialisable... Ts>
+    using variant = basic_variant<compact_format, Ts...>;
 
+    // variant which can refer to variable data anywhere in a buffer larger than 4 GiB.
     template<serialisable... Ts>
-    struct fixed_data_size<variant<Ts...>>
-        : detail::size_t_constant<fixed_data_size_v<variant_index_t> + fixed_data_size_v<data_offset_t>> {};
+    using large_variant = basic_variant<large_format, Ts...>;
+
 
+    template<format_profile Format, serialisable... Ts>
+    struct fixed_data_size<basic_variant<Format, Ts...>> : detail::size_t_constant<
+        fixed_data_size_v<variant_index_t> + fixed_data_size_v<typename Format::offset_type>> {};
 
-    template<>
-    class serialise_source<variant<>> : public std::variant<std::monostate> {
+
+    template<format_profile Format>
+    class serialise_source<basic_variant<Format>> : public std::variant<std::monostate> {
     public:
         using std::variant<std::monostate>::variant;
     };
 
-    template<serialisable... Ts>
-    class serialise_source<variant<Ts...>> : public std::variant<serialise_source<Ts>...> {
+    template<format_profile Format, serialisable... Ts>
+    class serialise_source<basic_variant<Format, Ts...>> : public std::variant<serialise_source<Ts>...> {
     public:
         // TODO: is having the in_place_ constructors explicit good for us?
         using std::variant<serialise_source<Ts>...>::variant;
     };
 
 
-    template<serialisable... Ts>
-    struct serialiser<variant<Ts...>> {
-        static constexpr void serialise(serialise_source<variant<Ts...>> const& source, serialise_buffer auto& buffer,
-                std::size_t fixed_offset) {
+    template<format_profile Format, serialisable... Ts>
+    struct serialiser<basic_variant<Format, Ts...>> {
+        using _offset_type = Format::offset_type;
+
+        static constexpr void serialise(serialise_source<basic_variant<Format, Ts...>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
             if (source.valueless_by_exception()) {
                 throw std::bad_variant_access{};
             }
@@ -77,38 +89,56 @@ namespace serialpp {
             fixed_offset = push_fixed_subobject<variant_index_t>(fixed_offset,
                 detail::bind_serialise(serialise_source<variant_index_t>{index}, buffer));
 
-            auto const variable_offset = buffer.span().size();
-            auto const offset = sizeof...(Ts) > 0 ? detail::to_data_offset(variable_offset) : data_offset_t{0};
-            fixed_offset = push_fixed_subobject<data_offset_t>(fixed_offset,
-                detail::bind_serialise(serialise_source<data_offset_t>{offset}, buffer));
-
+            // Value is serialised first, since the buffer may relocate it if it deduplicates variable data.
+            std::size_t variable_offset = 0;
             if constexpr (sizeof...(Ts) > 0) {
-                std::visit([&buffer] <serialisable T> (serialise_source<T> const& value_source) {
-                    push_variable_subobjects<T>(1, buffer, detail::bind_serialise(value_source, buffer));
+                variable_offset = std::visit([&buffer] <serialisable T> (serialise_source<T> const& value_source) {
+                    return push_variable_subobjects<T>(1, buffer, detail::bind_serialise(value_source, buffer));
                 }, source);
             }
+
+            auto const offset =
+                sizeof...(Ts) > 0 ? detail::to_data_offset<_offset_type>(variable_offset) : _offset_type{0};
+            fixed_offset = push_fixed_subobject<_offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<_offset_type>{offset}, buffer));
         }
 
-        static constexpr void serialise(serialise_source<variant<Ts...>> const&, mutable_bytes_span const buffer,
-                std::size_t fixed_offset) requires (sizeof...(Ts) == 0) {
+        static constexpr void serialise(serialise_source<basic_variant<Format, Ts...>> const&,
+                mutable_bytes_span const buffer, std::size_t fixed_offset) requires (sizeof...(Ts) == 0) {
             fixed_offset = push_fixed_subobject<variant_index_t>(fixed_offset,
                 detail::bind_serialise(serialise_source<variant_index_t>{0}, buffer));
 
-            fixed_offset = push_fixed_subobject<data_offset_t>(fixed_offset,
-                detail::bind_serialise(serialise_source<data_offset_t>{0}, buffer));
+            fixed_offset = push_fixed_subobject<_offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<_offset_type>{0}, buffer));
+        }
+
+        static constexpr std::size_t variable_data_size(serialise_source<basic_variant<Format, Ts...>> const& source)
+                requires (size_precomputable<Ts> && ...) {
+            if (source.valueless_by_exception()) {
+                throw std::bad_variant_access{};
+            }
+
+            if constexpr (sizeof...(Ts) > 0) {
+                return std::visit([] <serialisable T> (serialise_source<T> const& value_source) {
+                    return fixed_data_size_v<T> + serialpp::variable_data_size<T>(value_source);
+                }, source);
+            }
+            else {
+                return 0;
+            }
         }
     };
 
 
-    template<serialisable... Ts>
-    class deserialiser<variant<Ts...>> : public deserialiser_base {
+    template<format_profile Format, serialisable... Ts>
+    class deserialiser<basic_variant<Format, Ts...>> : public deserialiser_base {
     public:
         using deserialiser_base::deserialiser_base;
 
         // Gets the zero-based index of the contained type.
         [[nodiscard]]
         constexpr std::size_t index() const requires (sizeof...(Ts) > 0) {
-            return deserialise<variant_index_t>(_buffer, _fixed_offset);
+            return _deserialise<variant_index_t>(_fixed_offset);
         }
 
         // If Index == index(), gets the contained value. Otherwise, throws std::bad_variant_access.
@@ -132,17 +162,35 @@ namespace serialpp {
             }
         }
 
+        // Checks that the type index is valid and the contained value can be deserialised.
+        constexpr void validate_subobjects(parallel_executor const* const parallel = nullptr) const
+                requires (validatable<Ts> && ...) {
+            if constexpr (sizeof...(Ts) > 0) {
+                auto const index = this->index();
+                if (index >= sizeof...(Ts)) {
+                    throw invalid_value_error{
+                        std::format("variant type index {} is out of range for variant with {} types",
+                            index, sizeof...(Ts))};
+                }
+                auto const offset = _offset();
+                [this, index, offset, parallel] <std::size_t... Is> (std::index_sequence<Is...>) {
+                    (void)((Is == index ? (detail::validate_object<Ts>(_buffer, offset, parallel), true) : false)
+                        || ...);
+                }(std::index_sequence_for<Ts...>{});
+            }
+        }
+
     private:
         [[nodiscard]]
-        constexpr data_offset_t _offset() const requires (sizeof...(Ts) > 0) {
-            return deserialise<data_offset_t>(_buffer, _fixed_offset + fixed_data_size_v<variant_index_t>);
+        constexpr std::size_t _offset() const requires (sizeof...(Ts) > 0) {
+            return _deserialise<typename Format::offset_type>(_fixed_offset + fixed_data_size_v<variant_index_t>);
         }
 
         // Gets the contained value by index.
         template<std::size_t Index> requires (Index < sizeof...(Ts))
         constexpr auto _get() const {
             using element_type = detail::type_list_element<type_list<Ts...>, Index>::type;
-            return deserialise<element_type>(_buffer, _offset());
+            return _deserialise<element_type>(_offset());
         }
 
         template<std::size_t I, typename F>
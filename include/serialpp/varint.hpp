@@ -0,0 +1,464 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+#include "dynamic_array.hpp"
+#include "scalar.hpp"
+#include "utility.hpp"
+
+
+namespace serialpp {
+
+    /*
+        packed_dynamic_array:
+            Fixed data is an element count (Format::size_type), a byte count (Format::size_type) and an offset
+            (Format::offset_type).
+            If the element count is > 0, then the variable data starting at the offset is byte count bytes, containing
+            the elements encoded as LEB128: 7 bits per byte, least significant group first, with the high bit of each
+            byte set if more bytes follow.
+            If the element count is 0, then the byte count and offset are 0 and no variable data is present.
+
+        Elements are encoded according to the element encoding:
+            varint<U>: the value itself.
+            zigzag<S>: the value mapped to an unsigned integer such that small magnitudes encode small, i.e. 0, -1, 1,
+                -2, 2, ... map to 0, 1, 2, 3, 4, ...
+    */
+
+
+    // Element encoding for packed_dynamic_array, which stores unsigned integers in 1 byte per 7 significant bits.
+    template<std::unsigned_integral U> requires (!std::same_as<U, bool>)
+    struct varint {
+        using value_type = U;
+        using encoded_type = U;
+
+        [[nodiscard]]
+        static constexpr encoded_type encode(value_type const value) noexcept {
+            return value;
+        }
+
+        [[nodiscard]]
+        static constexpr value_type decode(encoded_type const value) noexcept {
+            return value;
+        }
+    };
+
+
+    // Element encoding for packed_dynamic_array, which stores signed integers in 1 byte per 7 significant bits (plus a
+    // sign bit).
+    template<std::signed_integral S>
+    struct zigzag {
+        using value_type = S;
+        using encoded_type = std::make_unsigned_t<S>;
+
+        [[nodiscard]]
+        static constexpr encoded_type encode(value_type const value) noexcept {
+            auto const bits = static_cast<encoded_type>(value);
+            // All 1s if negative, otherwise all 0s.
+            auto const sign = static_cast<encoded_type>(0 - (bits >> (std::numeric_limits<encoded_type>::digits - 1)));
+            return static_cast<encoded_type>(static_cast<encoded_type>(bits << 1) ^ sign);
+        }
+
+        [[nodiscard]]
+        static constexpr value_type decode(encoded_type const value) noexcept {
+            auto const sign = static_cast<encoded_type>(0 - (value & 1u));
+            return static_cast<value_type>(static_cast<encoded_type>(value >> 1) ^ sign);
+        }
+    };
+
+
+    // Element encoding usable with packed_dynamic_array. It requires:
+    //   - value_type: the integer type of the elements.
+    //   - encoded_type: the unsigned integer type which is LEB128 encoded.
+    //   - static encode(value_type) -> encoded_type and decode(encoded_type) -> value_type, which are inverses.
+    template<typename E>
+    concept varint_encoding = std::integral<typename E::value_type>
+        && std::unsigned_integral<typename E::encoded_type>
+        && requires(typename E::value_type const value, typename E::encoded_type const encoded) {
+            { E::encode(value) } noexcept -> std::same_as<typename E::encoded_type>;
+            { E::decode(encoded) } noexcept -> std::same_as<typename E::value_type>;
+        };
+
+
+    namespace detail {
+
+        // Maximum number of bytes of the LEB128 encoding of a U.
+        template<std::unsigned_integral U>
+        inline constexpr std::size_t max_varint_size = (std::numeric_limits<U>::digits + 6) / 7;
+
+
+        // Gets the number of bytes of the LEB128 encoding of value.
+        template<std::unsigned_integral U>
+        [[nodiscard]]
+        constexpr std::size_t varint_size(U const value) noexcept {
+            return std::max<std::size_t>((std::bit_width(value) + 6) / 7, 1);
+        }
+
+
+        // Writes the LEB128 encoding of value into buffer at offset, and returns the offset after it.
+        template<std::unsigned_integral U>
+        constexpr std::size_t encode_varint(U value, mutable_bytes_span const buffer, std::size_t offset) noexcept {
+            while (value >= 0x80u) {
+                buffer[offset++] = static_cast<std::byte>((value & 0x7Fu) | 0x80u);
+                value = static_cast<U>(value >> 7);
+            }
+            buffer[offset++] = static_cast<std::byte>(value);
+            return offset;
+        }
+
+
+        // Reads a LEB128 encoded U from buffer at offset, and advances offset past it.
+        // Throws invalid_value_error if the encoding is truncated by the end of buffer, or the value doesn't fit in U.
+        template<std::unsigned_integral U>
+        [[nodiscard]]
+        constexpr U decode_varint(const_bytes_span const buffer, std::size_t& offset) {
+            constexpr auto digits = static_cast<unsigned>(std::numeric_limits<U>::digits);
+            U value = 0;
+            unsigned shift = 0;
+            while (true) {
+                if (offset >= buffer.size()) {
+                    throw invalid_value_error{std::format("varint at offset {} is truncated", offset)};
+                }
+                auto const byte = std::to_integer<std::uint64_t>(buffer[offset++]);
+                auto const group = byte & 0x7Fu;
+                if (shift >= digits || (shift > 0 && (group >> (digits - shift)) != 0)) {
+                    throw invalid_value_error{
+                        std::format("varint ending at offset {} is too big for {}-bit integer", offset, digits)};
+                }
+                value |= static_cast<U>(group << shift);
+                if ((byte & 0x80u) == 0) {
+                    return value;
+                }
+                shift += 7;
+            }
+        }
+
+
+        // Decodes output.size() consecutive varint_encoding E elements from the start of buffer into output, converting
+        // each to U.
+        // Throws invalid_value_error if buffer doesn't contain exactly output.size() valid encoded elements.
+        template<varint_encoding E, typename U, std::size_t Extent>
+        constexpr void decode_varints(const_bytes_span const buffer, std::span<U, Extent> const output) {
+            using encoded_type = E::encoded_type;
+            std::size_t offset = 0;
+            std::size_t i = 0;
+            while (i < output.size()) {
+                // Fast path for runs of single byte elements, which are usually the most common. Checking 8 bytes at
+                // once is easily vectorised.
+                while (output.size() - i >= 8 && buffer.size() - offset >= 8) {
+                    std::byte high_bits{0};
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        high_bits |= buffer[offset + j];
+                    }
+                    if ((high_bits & std::byte{0x80}) != std::byte{0}) {
+                        break;
+                    }
+                    for (std::size_t j = 0; j < 8; ++j) {
+                        auto const encoded = static_cast<encoded_type>(std::to_integer<unsigned>(buffer[offset + j]));
+                        output[i + j] = U(E::decode(encoded));
+                    }
+                    i += 8;
+                    offset += 8;
+                }
+                if (i < output.size()) {
+                    output[i] = U(E::decode(decode_varint<encoded_type>(buffer, offset)));
+                    ++i;
+                }
+            }
+            if (offset != buffer.size()) {
+                throw invalid_value_error{
+                    std::format("packed_dynamic_array has {} bytes after its {} elements",
+                        buffer.size() - offset, output.size())};
+            }
+        }
+
+    }
+
+
+    // Serialisable variable-length array of integers, each encoded in as few bytes as possible (1 byte per 7
+    // significant bits).
+    // E is the element encoding, either varint<U> for unsigned integers or zigzag<S> for signed integers. Elements are
+    // decoded sequentially, so there is no random access.
+    // Format determines the size of the element count and offset (see format_profile).
+    template<varint_encoding E, format_profile Format = compact_format>
+    struct packed_dynamic_array {
+        using element_encoding = E;
+        using value_type = E::value_type;
+        using format = Format;
+    };
+
+
+    template<varint_encoding E, format_profile Format>
+    struct fixed_data_size<packed_dynamic_array<E, Format>> : detail::size_t_constant<
+        2 * fixed_data_size_v<typename Format::size_type> + fixed_data_size_v<typename Format::offset_type>> {};
+
+
+    // Constructible from a braced-init-list of integers, or a std::vector rvalue of integers (which are owned), or a
+    // std::span of integers (which are referenced).
+    template<varint_encoding E, format_profile Format>
+    class serialise_source<packed_dynamic_array<E, Format>> : public detail::maybe_owned_span<typename E::value_type> {
+    public:
+        using value_type = E::value_type;
+
+        using detail::maybe_owned_span<value_type>::maybe_owned_span;
+
+        // Gets the elements to be serialised.
+        [[nodiscard]]
+        constexpr std::span<value_type const> elements() const noexcept {
+            return this->get();
+        }
+    };
+
+
+    template<varint_encoding E, format_profile Format>
+    struct serialiser<packed_dynamic_array<E, Format>> {
+        static constexpr void serialise(serialise_source<packed_dynamic_array<E, Format>> const& source,
+                serialise_buffer auto& buffer, std::size_t fixed_offset) {
+            using size_type = Format::size_type;
+            using offset_type = Format::offset_type;
+
+            auto const elements = source.elements();
+            auto const count = detail::to_dynamic_array_size<Format>(elements.size());
+            size_type byte_count = 0;
+            offset_type offset = 0;
+            if (!elements.empty()) {
+                // Measure first so the buffer is only extended once, and the byte count is checked before extending.
+                auto const size = variable_data_size(source);
+                byte_count = detail::to_size_type<Format>(size, "packed_dynamic_array byte count");
+                auto const bytes_offset = push_variable_subobjects<std::byte>(size, buffer,
+                    [&buffer, elements](std::size_t bytes_offset) {
+                        auto const bytes = buffer.span();
+                        for (auto const element : elements) {
+                            bytes_offset = detail::encode_varint(E::encode(element), bytes, bytes_offset);
+                        }
+                    });
+                offset = detail::to_data_offset<offset_type>(bytes_offset);
+            }
+
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<size_type>{count}, buffer));
+            fixed_offset = push_fixed_subobject<size_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<size_type>{byte_count}, buffer));
+            fixed_offset = push_fixed_subobject<offset_type>(fixed_offset,
+                detail::bind_serialise(serialise_source<offset_type>{offset}, buffer));
+        }
+
+        static constexpr std::size_t variable_data_size(
+                serialise_source<packed_dynamic_array<E, Format>> const& source) {
+            std::size_t size = 0;
+            for (auto const element : source.elements()) {
+                size += detail::varint_size(E::encode(element));
+            }
+            return size;
+        }
+    };
+
+
+    // Forward view of the elements of a serialised packed_dynamic_array, obtained from
+    // deserialiser<packed_dynamic_array<E, Format>>::elements().
+    // Elements are decoded as the view is iterated. References only the buffer, so may outlive the deserialiser it was
+    // obtained from. Likewise, iterators may outlive the view.
+    template<varint_encoding E>
+    class packed_dynamic_array_view : public std::ranges::view_interface<packed_dynamic_array_view<E>> {
+    public:
+        using value_type = E::value_type;
+
+        class iterator {
+        public:
+            using value_type = E::value_type;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            [[nodiscard]]
+            constexpr value_type operator*() const noexcept {
+                return _value;
+            }
+
+            constexpr iterator& operator++() {
+                ++_index;
+                _decode();
+                return *this;
+            }
+
+            constexpr iterator operator++(int) {
+                auto const old = *this;
+                ++*this;
+                return old;
+            }
+
+            [[nodiscard]]
+            friend constexpr bool operator==(iterator const& lhs, iterator const& rhs) noexcept {
+                return lhs._index == rhs._index;
+            }
+
+        private:
+            friend class packed_dynamic_array_view;
+
+            // The iterator holds what it needs from the view, so it remains valid after the view is destroyed.
+            const_bytes_span _bytes;
+            std::size_t _size = 0;
+            std::size_t _index = 0;
+            // Offset of the next encoded element within _bytes.
+            std::size_t _offset = 0;
+            value_type _value{};
+
+            constexpr iterator(packed_dynamic_array_view const& view, std::size_t const index) :
+                _bytes{view._bytes}, _size{view._size}, _index{index}
+            {
+                _decode();
+            }
+
+            // Decodes the element at _index, if there is one.
+            constexpr void _decode() {
+                if (_index < _size) {
+                    _value = E::decode(detail::decode_varint<typename E::encoded_type>(_bytes, _offset));
+                }
+            }
+        };
+
+        packed_dynamic_array_view() = default;
+
+        [[nodiscard]]
+        constexpr iterator begin() const {
+            return iterator{*this, 0};
+        }
+
+        [[nodiscard]]
+        constexpr iterator end() const {
+            return iterator{*this, _size};
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+    private:
+        template<typename>
+        friend class deserialiser;
+
+        const_bytes_span _bytes;
+        std::size_t _size = 0;
+
+        constexpr packed_dynamic_array_view(const_bytes_span const bytes, std::size_t const size) noexcept :
+            _bytes{bytes}, _size{size}
+        {}
+    };
+
+
+    template<varint_encoding E, format_profile Format>
+    class deserialiser<packed_dynamic_array<E, Format>> : public deserialiser_base {
+    public:
+        using value_type = E::value_type;
+
+        using deserialiser_base::deserialiser_base;
+
+        // Gets the number of elements in the packed_dynamic_array.
+        [[nodiscard]]
+        constexpr std::size_t size() const {
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(_fixed_offset));
+        }
+
+        // Checks if the packed_dynamic_array contains zero elements.
+        [[nodiscard]]
+        constexpr bool empty() const {
+            return size() == 0;
+        }
+
+        // Gets the number of bytes of the encoded elements.
+        [[nodiscard]]
+        constexpr std::size_t byte_size() const {
+            auto const byte_size_offset = _fixed_offset + fixed_data_size_v<typename Format::size_type>;
+            return static_cast<std::size_t>(_deserialise<typename Format::size_type>(byte_size_offset));
+        }
+
+        // Gets a forward view of the elements, which decodes them as it is iterated.
+        // Throws buffer_bounds_error if the encoded elements are out of bounds.
+        [[nodiscard]]
+        constexpr packed_dynamic_array_view<E> elements() const {
+            return packed_dynamic_array_view<E>{_bytes(), size()};
+        }
+
+        // Decodes all elements into the beginning of output, converting each to U (which must not narrow), and
+        // returns the part of output which was written.
+        // This is faster than iterating elements().
+        // Throws std::out_of_range if output is smaller than size().
+        template<typename U, std::size_t Extent> requires detail::scalar_convertible_to<value_type, U>
+        constexpr std::span<U> copy_to(std::span<U, Extent> const output) const {
+            auto const size = this->size();
+            if (output.size() < size) {
+                throw std::out_of_range{
+                    std::format("output of size {} is too small for packed_dynamic_array with size {}",
+                        output.size(), size)};
+            }
+            auto const written = output.first(size);
+            detail::decode_varints<E>(_bytes(), written);
+            return written;
+        }
+
+        // Decodes all elements into a new std::vector, converting each to U (which must not narrow).
+        template<typename U = value_type> requires detail::scalar_convertible_to<value_type, U>
+        [[nodiscard]]
+        constexpr std::vector<U> to_vector() const {
+            std::vector<U> result(size());
+            (void)copy_to(std::span{result});
+            return result;
+        }
+
+        // Checks that the encoded elements are within the buffer, and that they are exactly size() valid elements.
+        constexpr void validate_subobjects(parallel_executor const* = nullptr) const {
+            auto const bytes = _bytes();
+            std::size_t offset = 0;
+            for (std::size_t i = 0, size = this->size(); i < size; ++i) {
+                (void)detail::decode_varint<typename E::encoded_type>(bytes, offset);
+            }
+            if (offset != bytes.size()) {
+                throw invalid_value_error{
+                    std::format("packed_dynamic_array has {} bytes after its elements", bytes.size() - offset)};
+            }
+        }
+
+    private:
+        // Gets the encoded elements. The bounds are always checked, since decoding relies on them.
+        [[nodiscard]]
+        constexpr const_bytes_span _bytes() const {
+            if (size() == 0) {
+                return {};
+            }
+            auto const offset_offset = _fixed_offset + 2 * fixed_data_size_v<typename Format::size_type>;
+            auto const offset = static_cast<std::size_t>(_deserialise<typename Format::offset_type>(offset_offset));
+            auto const byte_size = this->byte_size();
+            if (offset > _buffer.size() || _buffer.size() - offset < byte_size) {
+                throw buffer_bounds_error{
+                    std::format("Data buffer of size {} is too small to deserialise {} bytes of packed elements at "
+                        "offset {}", _buffer.size(), byte_size, offset)};
+            }
+            return _buffer.subspan(offset, byte_size);
+        }
+    };
+
+}
+
+
+namespace std::ranges {
+
+    // Iterators of packed_dynamic_array_view reference only the buffer, so they may outlive the view.
+    template<::serialpp::varint_encoding E>
+    inline constexpr bool enable_borrowed_range<::serialpp::packed_dynamic_array_view<E>> = true;
+
+}
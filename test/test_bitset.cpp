@@ -0,0 +1,217 @@
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <serialpp/bitset.hpp>
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block bitset_tests = [] {
+
+    static_assert(fixed_size_serialisable<static_bitset<10>>);
+    static_assert(fixed_data_size_v<static_bitset<1>> == 1);
+    static_assert(fixed_data_size_v<static_bitset<8>> == 1);
+    static_assert(fixed_data_size_v<static_bitset<9>> == 2);
+    static_assert(fixed_data_size_v<static_bitset<100>> == 13);
+    static_assert(variable_size_serialisable<bitset_array<>>);
+    static_assert(size_precomputable<bitset_array<>>);
+    static_assert(validatable<bitset_array<>>);
+    static_assert(fixed_data_size_v<bitset_array<>> == 4 + 4);
+    static_assert(fixed_data_size_v<bitset_array<large_format>> == 8 + 8);
+
+    test_case("serialise() static_bitset") = [] {
+        using type = static_bitset<12>;
+        serialise_source<type> const source{0b1001'0110'0011};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 2> const expected_buffer{0x63, 0x09};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 12);
+        test_assert(deser[0]);
+        test_assert(!deser[2]);
+        test_assert(deser[11]);
+        test_assert(deser.bits().count() == 6);
+        test_assert(deser.to_bitset() == std::bitset<12>{0b1001'0110'0011});
+    };
+
+    test_case("serialise() static_bitset large") = [] {
+        using type = static_bitset<150>;
+        std::bitset<150> bits;
+        bits.set(3);
+        bits.set(64);
+        bits.set(149);
+        serialise_source<type> const source{bits};
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(buffer.span().size() == 19);
+        test_assert(buffer.span()[0] == std::byte{0x08});
+        test_assert(buffer.span()[8] == std::byte{0x01});
+        test_assert(buffer.span()[18] == std::byte{0x20});
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.to_bitset() == bits);
+        auto const view = deser.bits();
+        test_assert(view.find_first() == 3);
+        test_assert(view.find_next(3) == 64);
+        test_assert(view.find_next(64) == 149);
+        test_assert(view.find_next(149) == 150);
+    };
+
+    test_case("serialise() bitset_array") = [] {
+        using type = bitset_array<>;
+        serialise_source<type> const source{{true, false, true, true, false, false, false, false, false, true}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 10> const expected_buffer{
+            0x0A, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x0D, 0x02                  // Bits
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 10);
+        test_assert(deser[3]);
+        test_assert(!deser[4]);
+        test_assert(deser.bits().to_vector()
+            == std::vector<bool>{true, false, true, true, false, false, false, false, false, true});
+    };
+
+    test_case("serialise() bitset_array empty") = [] {
+        using type = bitset_array<>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 8> const expected_buffer{};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.empty());
+        test_assert(deser.bits().none());
+        test_assert(deser.bits().all());
+        test_assert(deser.bits().find_first() == 0);
+    };
+
+    test_case("bitset_array sources agree") = [] {
+        using type = bitset_array<>;
+        std::vector<bool> bools;
+        std::vector<std::uint8_t> bytes;
+        for (std::size_t i = 0; i < 203; ++i) {
+            bool const bit = i % 3 == 0 || i % 7 == 0;
+            bools.push_back(bit);
+            bytes.push_back(bit);
+        }
+        std::vector<bool> const plain(bytes.begin(), bytes.end());
+        std::span<bool const> const span{reinterpret_cast<bool const*>(bytes.data()), bytes.size()};
+
+        basic_buffer vector_buffer;
+        serialise(serialise_source<type>{plain}, vector_buffer);
+        basic_buffer span_buffer;
+        serialise(serialise_source<type>{span}, span_buffer);
+        test_assert(std::ranges::equal(vector_buffer.span(), span_buffer.span()));
+
+        auto const deser = validate<type>(span_buffer.span());
+        test_assert(deser.bits().to_vector() == bools);
+        test_assert(deser.bits().to_vector<std::uint8_t>() == bytes);
+    };
+
+    test_case("bitset_view count() and find_next()") = [] {
+        using type = bitset_array<>;
+        std::vector<bool> bits(1000);
+        bits[0] = true;
+        bits[63] = true;
+        bits[64] = true;
+        bits[500] = true;
+        bits[999] = true;
+        serialise_source<type> const source{std::move(bits)};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const view = deserialise<type>(buffer.span()).bits();
+        test_assert(view.count() == 5);
+        test_assert(view.any());
+        test_assert(!view.all());
+        std::vector<std::size_t> found;
+        for (auto i = view.find_first(); i < view.size(); i = view.find_next(i)) {
+            found.push_back(i);
+        }
+        test_assert(found == std::vector<std::size_t>{0, 63, 64, 500, 999});
+    };
+
+    test_case("bitset_view ignores padding bits") = [] {
+        std::array<unsigned char, 10> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0xF8, 0xFF                  // Bits (only the lowest 3 are used)
+        };
+        using type = bitset_array<>;
+        auto const view = validate<type>(as_const_bytes_span(buffer)).bits();
+        test_assert(view.count() == 0);
+        test_assert(view.none());
+        test_assert(view.find_first() == 3);
+    };
+
+    test_case("bitset_view copy_to()") = [] {
+        using type = static_bitset<20>;
+        serialise_source<type> const source{0xA5A5A};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const view = deserialise<type>(buffer.span()).bits();
+        std::array<bool, 24> output{};
+        auto const written = view.copy_to(std::span{output});
+        test_assert(written.size() == 20);
+        for (std::size_t i = 0; i < 20; ++i) {
+            test_assert(output[i] == (((0xA5A5Au >> i) & 1u) != 0));
+        }
+
+        std::array<std::uint8_t, 19> small_output{};
+        test_assert_throws<std::out_of_range>([&view, &small_output] {
+            (void)view.copy_to(std::span{small_output});
+        });
+        test_assert_throws<std::out_of_range>([&view] {
+            (void)view.test(20);
+        });
+    };
+
+    test_case("bitset_array in dynamic_array") = [] {
+        using type = dynamic_array<bitset_array<large_format>>;
+        serialise_source<type> const source{{{true, true}, {}, {false, false, true}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser[0].bits().all());
+        test_assert(deser[1].empty());
+        test_assert(deser[2].bits().find_first() == 2);
+    };
+
+    test_case("validate() bitset_array bits out of bounds") = [] {
+        std::array<unsigned char, 9> const buffer{
+            0x09, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0xFF                        // Bits (should be 2 bytes)
+        };
+        using type = bitset_array<>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+};
+}
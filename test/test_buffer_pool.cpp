@@ -0,0 +1,140 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <serialpp/buffer_pool.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/scalar.hpp>
+
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block buffer_pool_tests = [] {
+
+    static_assert(serialise_buffer<pooled_buffer>);
+
+    test_case("buffer_pool acquire() new buffer") = [] {
+        buffer_pool pool{1};
+        pooled_buffer const buffer = pool.acquire(5000);
+        test_assert(buffer.capacity() == 8192);
+        test_assert(buffer.span().empty());
+        test_assert(pool.outstanding(5000) == 1);
+        test_assert(pool.high_water_mark(5000) == 1);
+    };
+
+    test_case("buffer_pool acquire() minimum capacity") = [] {
+        buffer_pool pool{1};
+        pooled_buffer const buffer = pool.acquire();
+        test_assert(buffer.capacity() == buffer_pool::min_capacity);
+    };
+
+    test_case("buffer_pool acquire() capacity too big") = [] {
+        buffer_pool pool{1};
+        test_assert_throws<std::bad_alloc>([&pool] {
+            (void)pool.acquire(std::numeric_limits<std::size_t>::max());
+        });
+        test_assert(pool.outstanding(std::numeric_limits<std::size_t>::max()) == 0);
+    };
+
+    test_case("buffer_pool reuses released buffers") = [] {
+        buffer_pool pool{1};
+        std::byte const* data;
+        {
+            pooled_buffer buffer = pool.acquire(1000);
+            buffer.initialise(10);
+            data = buffer.span().data();
+        }
+        test_assert(pool.outstanding(1000) == 0);
+        pooled_buffer buffer = pool.acquire(1000);
+        buffer.initialise(10);
+        test_assert(buffer.span().data() == data);
+        test_assert(pool.high_water_mark(1000) == 1);
+    };
+
+    test_case("buffer_pool reuses grown buffers") = [] {
+        buffer_pool pool{1};
+        {
+            pooled_buffer buffer = pool.acquire(4096);
+            buffer.initialise(4096);
+            buffer.extend(10'000);
+        }
+        pooled_buffer const buffer = pool.acquire(16'384);
+        test_assert(buffer.capacity() >= 16'384);
+        test_assert(pool.outstanding(4096) == 0);
+        test_assert(pool.outstanding(16'384) == 1);
+    };
+
+    test_case("buffer_pool high_water_mark()") = [] {
+        buffer_pool pool{1};
+        {
+            std::vector<pooled_buffer> buffers;
+            for (int i = 0; i < 3; ++i) {
+                buffers.push_back(pool.acquire(100));
+            }
+            test_assert(pool.outstanding(100) == 3);
+        }
+        pooled_buffer const buffer = pool.acquire(100);
+        test_assert(pool.outstanding(100) == 1);
+        test_assert(pool.high_water_mark(100) == 3);
+        test_assert(pool.high_water_mark(100'000) == 0);
+    };
+
+    test_case("buffer_pool clear()") = [] {
+        buffer_pool pool{1};
+        {
+            pooled_buffer const buffer = pool.acquire();
+        }
+        pool.clear();
+        pooled_buffer const buffer = pool.acquire();
+        test_assert(pool.outstanding(0) == 1);
+    };
+
+    test_case("pooled_buffer move assign") = [] {
+        buffer_pool pool{1};
+        pooled_buffer buffer1 = pool.acquire();
+        buffer1.initialise(10);
+        buffer1.span()[0] = std::byte{42};
+        pooled_buffer buffer2 = pool.acquire();
+        buffer2 = std::move(buffer1);
+        test_assert(buffer2.span().size() == 10);
+        test_assert(buffer2.span()[0] == std::byte{42});
+        test_assert(pool.outstanding(0) == 1);
+    };
+
+    test_case("pooled_buffer serialise()") = [] {
+        using type = dynamic_array<std::uint16_t>;
+        buffer_pool pool;
+        pooled_buffer buffer = pool.acquire();
+        serialise(serialise_source<type>{{1, 2, 3}}, buffer);
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 3);
+        test_assert(deser[2] == 3);
+    };
+
+    test_case("buffer_pool multithreaded") = [] {
+        buffer_pool pool{4};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&pool] {
+                for (int i = 0; i < 1000; ++i) {
+                    pooled_buffer buffer = pool.acquire(100);
+                    buffer.initialise(100);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        test_assert(pool.outstanding(100) == 0);
+        test_assert(pool.high_water_mark(100) >= 1);
+        test_assert(pool.high_water_mark(100) <= 8);
+    };
+
+};
+}
@@ -1,4 +1,8 @@
+#include <array>
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <utility>
 
 #include <serialpp/buffers.hpp>
@@ -12,6 +16,14 @@ namespace serialpp::test {
 test_block buffers_tests = [] {
 
     static_assert(serialise_buffer<basic_buffer>);
+    static_assert(serialise_buffer<allocating_buffer<std::allocator<std::byte>, exact_growth>>);
+    static_assert(serialise_buffer<pmr::allocating_buffer<page_rounded_growth<>>>);
+    static_assert(serialise_buffer<span_buffer>);
+
+    static_assert(buffer_growth_policy<geometric_growth<>>);
+    static_assert(buffer_growth_policy<fixed_growth>);
+    static_assert(buffer_growth_policy<exact_growth>);
+    static_assert(buffer_growth_policy<page_rounded_growth<fixed_growth>>);
 
     test_case("basic_buffer default construct") = [] {
         basic_buffer buffer;
@@ -104,6 +116,20 @@ test_block buffers_tests = [] {
         test_assert(span2[99] == std::byte{42});
     };
 
+    test_case("basic_buffer truncate()") = [] {
+        basic_buffer buffer{150};
+        buffer.initialise(100);
+        mutable_bytes_span const span1 = buffer.span();
+        span1[0] = std::byte{10};
+        buffer.truncate(40);
+
+        mutable_bytes_span const span2 = buffer.span();
+        test_assert(span2.data() == span1.data());
+        test_assert(span2.size() == 40);
+        test_assert(span2[0] == std::byte{10});
+        test_assert(buffer.capacity() == 150);
+    };
+
     test_case("basic_buffer move construct") = [] {
         basic_buffer buffer1;
         buffer1.initialise(100);
@@ -137,5 +163,136 @@ test_block buffers_tests = [] {
         test_assert(span2[99] == std::byte{42});
     };
 
+    test_case("geometric_growth") = [] {
+        test_assert(geometric_growth<>{}.initial_capacity(100) == 100);
+        test_assert(geometric_growth<>{}.grown_capacity(50, 100) == 150);
+        test_assert(geometric_growth<>{}.grown_capacity(50, 101) == 151);
+        test_assert(geometric_growth<2, 1>{}.grown_capacity(10, 7) == 14);
+    };
+
+    test_case("fixed_growth") = [] {
+        fixed_growth const growth{.increment = 1000};
+        test_assert(growth.initial_capacity(100) == 100);
+        test_assert(growth.grown_capacity(500, 600) == 1500);
+        test_assert(growth.grown_capacity(500, 2000) == 2000);
+    };
+
+    test_case("exact_growth") = [] {
+        test_assert(exact_growth{}.initial_capacity(100) == 100);
+        test_assert(exact_growth{}.grown_capacity(50, 101) == 101);
+    };
+
+    test_case("page_rounded_growth") = [] {
+        page_rounded_growth<exact_growth> const growth;
+        test_assert(growth.initial_capacity(1) == 4096);
+        test_assert(growth.initial_capacity(4096) == 4096);
+        test_assert(growth.grown_capacity(4096, 4097) == 8192);
+        test_assert(growth.grown_capacity(0, 3 * 1024 * 1024) == 4 * 1024 * 1024);
+        test_assert(page_rounded_growth<>{}.grown_capacity(0, 4000) == 8192);
+    };
+
+    test_case("allocating_buffer growth policy") = [] {
+        allocating_buffer<std::allocator<std::byte>, exact_growth> buffer{100};
+        buffer.initialise(100);
+        buffer.extend(1);
+        test_assert(buffer.capacity() == 101);
+
+        allocating_buffer<std::allocator<std::byte>, fixed_growth> buffer2{100, true, {}, {.increment = 50}};
+        buffer2.initialise(100);
+        buffer2.extend(1);
+        test_assert(buffer2.capacity() == 150);
+        buffer2.initialise(200);
+        test_assert(buffer2.capacity() == 200);
+    };
+
+    test_case("pmr::allocating_buffer") = [] {
+        std::array<std::byte, 4096> storage{};
+        std::pmr::monotonic_buffer_resource arena{storage.data(), storage.size(), std::pmr::null_memory_resource()};
+        pmr::allocating_buffer<> buffer{64, false, &arena};
+        test_assert(buffer.get_allocator().resource() == &arena);
+        buffer.initialise(64);
+        buffer.span()[0] = std::byte{10};
+        buffer.span()[63] = std::byte{42};
+        buffer.extend(500);
+
+        auto const span = buffer.span();
+        test_assert(span.size() == 564);
+        test_assert(span.data() >= storage.data() && span.data() + span.size() <= storage.data() + storage.size());
+        test_assert(span[0] == std::byte{10});
+        test_assert(span[63] == std::byte{42});
+    };
+
+    test_case("pmr::allocating_buffer move assign different resource") = [] {
+        std::pmr::monotonic_buffer_resource arena1;
+        std::pmr::monotonic_buffer_resource arena2;
+        pmr::allocating_buffer<> buffer1{100, false, &arena1};
+        buffer1.initialise(100);
+        buffer1.span()[0] = std::byte{10};
+        buffer1.span()[99] = std::byte{42};
+        pmr::allocating_buffer<> buffer2{10, false, &arena2};
+
+        buffer2 = std::move(buffer1);
+        test_assert(buffer2.get_allocator().resource() == &arena2);
+        test_assert(buffer2.span().size() == 100);
+        test_assert(buffer2.span()[0] == std::byte{10});
+        test_assert(buffer2.span()[99] == std::byte{42});
+    };
+
+    test_case("span_buffer construct") = [] {
+        std::array<std::byte, 100> storage{};
+        span_buffer buffer{storage};
+        test_assert(buffer.capacity() == 100);
+        test_assert(buffer.span().empty());
+    };
+
+    test_case("span_buffer initialise() within capacity") = [] {
+        std::array<std::byte, 100> storage{};
+        span_buffer buffer{storage};
+        buffer.initialise(60);
+        test_assert(bytes_span_same(buffer.span(), mutable_bytes_span{storage}.first(60)));
+        buffer.initialise(100);
+        test_assert(bytes_span_same(buffer.span(), mutable_bytes_span{storage}));
+    };
+
+    test_case("span_buffer initialise() exceed capacity") = [] {
+        std::array<std::byte, 100> storage{};
+        span_buffer buffer{storage};
+        test_assert_throws<std::bad_alloc>([&buffer] {
+            buffer.initialise(101);
+        });
+    };
+
+    test_case("span_buffer extend() within capacity") = [] {
+        std::array<std::byte, 100> storage{};
+        span_buffer buffer{storage};
+        buffer.initialise(40);
+        buffer.span()[0] = std::byte{10};
+        buffer.span()[39] = std::byte{42};
+        buffer.extend(60);
+
+        mutable_bytes_span const span = buffer.span();
+        test_assert(bytes_span_same(span, mutable_bytes_span{storage}));
+        test_assert(span[0] == std::byte{10});
+        test_assert(span[39] == std::byte{42});
+    };
+
+    test_case("span_buffer truncate()") = [] {
+        std::array<std::byte, 100> storage{};
+        span_buffer buffer{storage};
+        buffer.initialise(60);
+        buffer.truncate(20);
+        test_assert(bytes_span_same(buffer.span(), mutable_bytes_span{storage}.first(20)));
+    };
+
+    test_case("span_buffer extend() exceed capacity") = [] {
+        std::array<std::byte, 100> storage{};
+        span_buffer buffer{storage};
+        buffer.initialise(40);
+        test_assert_throws<std::bad_alloc>([&buffer] {
+            buffer.extend(61);
+        });
+        test_assert(buffer.span().size() == 40);
+    };
+
 };
 }
@@ -35,6 +35,16 @@ test_block common_tests = [] {
     static_assert(!buffer_for<int, mock_serialisable<16, true>>);
 
 
+    static_assert(size_precomputable<mock_serialisable<16, false>>);
+    static_assert(!size_precomputable<mock_serialisable<16, true>>);
+    static_assert(!size_precomputable<std::hash<int>>);
+
+
+    static_assert(validatable<mock_serialisable<16, false>>);
+    static_assert(!validatable<mock_serialisable<16, true>>);
+    static_assert(!validatable<std::hash<int>>);
+
+
     static_assert(std::same_as<
         deserialise_t<mock_serialisable<3, false, false>>, deserialiser<mock_serialisable<3, false, false>>>);
     static_assert(std::same_as<deserialise_t<mock_serialisable<3, false, true>>, std::size_t>);
@@ -51,6 +61,18 @@ test_block common_tests = [] {
     };
 
 
+    test_case("to_size_type() valid") = [] {
+        test_assert(detail::to_size_type(123456, "test size") == 123456u);
+        test_assert(detail::to_size_type<large_format>(123'456'789'000ull, "test size") == 123'456'789'000ull);
+    };
+
+    test_case("to_size_type() invalid") = [] {
+        test_assert_throws<object_size_error>([] {
+            (void)detail::to_size_type(123'456'789'000ull, "test size");
+        });
+    };
+
+
     test_case("check_buffer_size_for() valid") = [] {
         std::array<std::byte, 100> buffer{};
         mutable_bytes_span const span{buffer};
@@ -76,6 +98,13 @@ test_block common_tests = [] {
     };
 
 
+    test_case("serialised_size() fixed_size_serialisable") = [] {
+        serialise_source<mock_serialisable<37, false>> const source;
+        test_assert(variable_data_size(source) == 0);
+        test_assert(serialised_size(source) == 37);
+    };
+
+
     test_case("with_buffer_for() variable_size_serialisable") = [] {
         basic_buffer buffer;
         with_buffer_for<mock_serialisable<6521, true>>(buffer, [](basic_buffer&) {});
@@ -112,12 +141,13 @@ test_block common_tests = [] {
         buffer.initialise(45);
 
         bool func_called = false;
-        push_variable_subobjects<mock_serialisable<8>>(6, buffer,
+        auto const offset = push_variable_subobjects<mock_serialisable<8>>(6, buffer,
             [&func_called, &buffer](std::size_t const subobject_fixed_offset) {
                 func_called = true;
                 test_assert(subobject_fixed_offset == 45);
             });
         test_assert(func_called);
+        test_assert(offset == 45);
 
         test_assert(buffer.span().size() == 93);
     };
@@ -133,7 +163,7 @@ test_block common_tests = [] {
                 test_assert(subobject_fixed_offset == 10);
 
                 bool func2_called = false;
-                push_variable_subobjects<mock_serialisable<4>>(4, buffer,
+                auto const offset = push_variable_subobjects<mock_serialisable<4>>(4, buffer,
                     [&func2_called, &buffer](std::size_t const subobject_fixed_offset) {
                         func2_called = true;
                         test_assert(subobject_fixed_offset == 100);
@@ -150,6 +180,7 @@ test_block common_tests = [] {
                         test_assert(new_fixed_offset == 102);
                     });
                 test_assert(func2_called);
+                test_assert(offset == 100);
 
                 test_assert(buffer.span().size() == 116);
             });
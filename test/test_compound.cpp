@@ -1,6 +1,10 @@
 #include <algorithm>
 #include <array>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 #include <serialpp/buffers.hpp>
 #include <serialpp/common.hpp>
@@ -105,6 +109,51 @@ test_block compound_tests = [] {
         test_assert(std::ranges::equal(inner1.elements(), expected_elements1));
     };
 
+    static_assert(validatable<dynamic_array<dynamic_array<std::uint16_t>>>);
+
+    test_case("validate() dynamic_array of dynamic_array") = [] {
+        std::array<unsigned char, 32> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Outer array size
+            0x08, 0x00, 0x00, 0x00,     // Outer array offset
+            0x03, 0x00, 0x00, 0x00,     // Inner array 0 size
+            0x18, 0x00, 0x00, 0x00,     // Inner array 0 offset
+            0x01, 0x00, 0x00, 0x00,     // Inner array 1 size
+            0x1E, 0x00, 0x00, 0x00,     // Inner array 1 offset
+            0x12, 0x34,     // Inner array 0 elements
+            0x4F, 0x7A,
+            0x31, 0x12,
+            0x11, 0x33,     // Inner array 1 elements
+        };
+
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        deserialiser<type> const deser = validate<type>(as_const_bytes_span(buffer));
+        test_assert(deser.size() == 2);
+        std::array<std::uint16_t, 3> const expected_elements0{13330, 31311, 4657};
+        test_assert(std::ranges::equal(deser[0].elements(), expected_elements0));
+        std::array<std::uint16_t, 1> const expected_elements1{13073};
+        test_assert(std::ranges::equal(deser[1].elements(), expected_elements1));
+    };
+
+    test_case("validate() dynamic_array of dynamic_array inner element out of bounds") = [] {
+        std::array<unsigned char, 32> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Outer array size
+            0x08, 0x00, 0x00, 0x00,     // Outer array offset
+            0x03, 0x00, 0x00, 0x00,     // Inner array 0 size
+            0x18, 0x00, 0x00, 0x00,     // Inner array 0 offset
+            0x02, 0x00, 0x00, 0x00,     // Inner array 1 size
+            0x1E, 0x00, 0x00, 0x00,     // Inner array 1 offset
+            0x12, 0x34,     // Inner array 0 elements
+            0x4F, 0x7A,
+            0x31, 0x12,
+            0x11, 0x33,     // Inner array 1 elements
+        };
+
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
 
     static_assert(fixed_data_size_v<variant<variant<std::uint64_t, std::int16_t>>> == 2 + 4);
 
@@ -388,6 +437,121 @@ test_block compound_tests = [] {
     };
 
 
+    static_assert(size_precomputable<compound_test_record2>);
+    static_assert(size_precomputable<compound_test_record3>);
+
+    test_case("serialised_size() compound record") = [] {
+        serialise_source<compound_test_record2> const source{
+            {
+                {{48815, 28759, 46627}},
+                123,
+                {}
+            },
+            {{
+                {{26676, 53866, 58316}},
+                148,
+                {}
+            }},
+            {{
+                {
+                    {{19768}},
+                    61,
+                    {}
+                },
+                {
+                    {},
+                    20,
+                    -34'562'034'598'108'927ll
+                }
+            }},
+            {{
+                {
+                    {{20}},
+                    1,
+                    {-857923}
+                },
+                {
+                    {},
+                    16,
+                    {}
+                }
+            }}
+        };
+        // Fixed data: 51 bytes. Variable data: 6 + 19 + 36 + 10 bytes.
+        test_assert(variable_data_size(source) == 71);
+        test_assert(serialised_size(source) == 122);
+
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(buffer.span().size() == 122);
+
+        basic_buffer presized_buffer{0};
+        serialise_presized(source, presized_buffer);
+        test_assert(presized_buffer.capacity() == 122);
+        test_assert(std::ranges::equal(presized_buffer.span(), buffer.span()));
+    };
+
+    test_case("serialise_batch()") = [] {
+        using type = optional<dynamic_array<std::uint16_t>>;
+        using array_source = serialise_source<dynamic_array<std::uint16_t>>;
+        std::array<serialise_source<type>, 3> const sources{
+            array_source{{1, 2, 3}},
+            std::nullopt,
+            array_source{{4000}}
+        };
+        basic_buffer buffer;
+        auto const index = serialise_batch<type>(sources, buffer);
+
+        std::array<unsigned char, 36> const expected_buffer{
+            0x05, 0x00, 0x00, 0x00,     // sources[0] value offset
+            0x03, 0x00, 0x00, 0x00,     // sources[0] array size
+            0x0C, 0x00, 0x00, 0x00,     // sources[0] array offset
+            0x01, 0x00,                 // sources[0] array elements
+            0x02, 0x00,
+            0x03, 0x00,
+            0x00, 0x00, 0x00, 0x00,     // sources[1] value offset
+            0x1B, 0x00, 0x00, 0x00,     // sources[2] value offset
+            0x01, 0x00, 0x00, 0x00,     // sources[2] array size
+            0x22, 0x00, 0x00, 0x00,     // sources[2] array offset
+            0xA0, 0x0F                  // sources[2] array elements
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+        test_assert(buffer.capacity() >= 36);
+
+        test_assert(index.size() == 3);
+        test_assert(index[0].offset == 0 && index[0].size == 18);
+        test_assert(index[1].offset == 18 && index[1].size == 4);
+        test_assert(index[2].offset == 22 && index[2].size == 14);
+
+        auto const deser0 = deserialise<type>(buffer.span(), index[0].offset);
+        test_assert(std::ranges::equal(deser0.value().elements(), std::array{1, 2, 3}));
+        test_assert(!deserialise<type>(buffer.span(), index[1].offset).has_value());
+        auto const deser2 = deserialise<type>(buffer.span(), index[2].offset);
+        test_assert(std::ranges::equal(deser2.value().elements(), std::array{4000}));
+    };
+
+    test_case("serialise_batch() empty") = [] {
+        basic_buffer buffer;
+        buffer.initialise(10);
+        auto const index = serialise_batch<std::uint32_t>(std::array<serialise_source<std::uint32_t>, 0>{}, buffer);
+        test_assert(index.empty());
+        test_assert(buffer.span().empty());
+    };
+
+    test_case("serialise_batch() large_format") = [] {
+        using type = large_dynamic_array<std::uint8_t>;
+        using source_type = serialise_source<type>;
+        std::array<source_type, 2> const sources{source_type{{1, 2}}, source_type{{3}}};
+        basic_buffer buffer;
+        auto const index = serialise_batch<type, large_format>(sources, buffer);
+        static_assert(std::same_as<decltype(index), std::vector<large_batch_entry> const>);
+
+        test_assert(index.size() == 2);
+        test_assert(index[0].offset == 0 && index[0].size == 18);
+        test_assert(index[1].offset == 18 && index[1].size == 17);
+        test_assert(deserialise<type>(buffer.span(), index[1].offset)[0] == 3);
+    };
+
     static_assert(fixed_data_size_v<constexpr_test_record> == 28);
 
     test_case("serialise()/2 constexpr") = [] {
@@ -424,6 +588,42 @@ test_block compound_tests = [] {
         }();
     };
 
+    test_case("serialise_presized() constexpr") = [] {
+        []() consteval {
+            basic_buffer buffer{0};
+            serialise_source<constexpr_test_record> source{
+                9'214'357,
+                {765, -50},
+                {71, 266, 76589},
+                {{11, 22, 33, 44}},
+                -685249,
+                serialise_source<std::int8_t>{48}
+            };
+            test_assert(serialised_size(source) == 33);
+            serialise_presized(source, buffer);
+
+            std::array<unsigned char, 33> const expected_buffer{
+                0x95, 0x99, 0x8C, 0x00,     // i32
+                0xFD, 0x02,                 // pair_u16_i8.first
+                0xCE,                       // pair_u16_i8.second
+                0x47,                       // tuple_u8_u16_u32[0]
+                0x0A, 0x01,                 // tuple_u8_u16_u32[1]
+                0x2D, 0x2B, 0x01, 0x00,     // tuple_u8_u16_u32[2]
+                0x0B,                       // sarray_u8 elements
+                0x16,
+                0x21,
+                0x2C,
+                0x1D, 0x00, 0x00, 0x00,     // opt_i32 value offset
+                0x01, 0x00,                 // var_u64_i8 type index
+                0x20, 0x00, 0x00, 0x00,     // var_u64_i8 value offset
+                0x3F, 0x8B, 0xF5, 0xFF,     // opt_i32 value
+                0x30                        // var_u64_i8 value
+            };
+            test_assert(buffer_equal(buffer, expected_buffer));
+            test_assert(buffer.capacity() == 33);
+        }();
+    };
+
     test_case("deserialise()/1 constexpr") = [] {
         []() consteval {
             std::array<unsigned char, 33> const buffer{
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dedup_buffer.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/optional.hpp>
+#include <serialpp/pair.hpp>
+#include <serialpp/scalar.hpp>
+
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block dedup_buffer_tests = [] {
+
+    static_assert(serialise_buffer<dedup_buffer<basic_buffer>>);
+    static_assert(detail::deduplicating_buffer<dedup_buffer<basic_buffer>>);
+    static_assert(truncatable_buffer<basic_buffer>);
+    static_assert(truncatable_buffer<span_buffer>);
+    static_assert(!detail::presizable_buffer<dedup_buffer<basic_buffer>>);
+
+    test_case("dedup_buffer dynamic_array elements") = [] {
+        using type = dynamic_array<dynamic_array<char>>;
+        serialise_source<type> const source{{
+            std::string_view{"abc"}, std::string_view{"xyz"}, std::string_view{"abc"}, std::string_view{"abc"}}};
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer};
+        serialise(source, dedup);
+
+        // Root, 4 elements' fixed data, then only 2 strings.
+        auto const bytes = buffer.span();
+        test_assert(bytes.size() == 8 + 4 * 8 + 3 + 3);
+        // Elements 2 and 3 refer to the same data as element 0.
+        test_assert(std::ranges::equal(bytes.subspan(8, 8), bytes.subspan(24, 8)));
+        test_assert(std::ranges::equal(bytes.subspan(8, 8), bytes.subspan(32, 8)));
+
+        auto const deser = deserialise<type>(bytes);
+        test_assert(deser.size() == 4);
+        test_assert(deser[0].to_vector() == std::vector<char>{'a', 'b', 'c'});
+        test_assert(deser[1].to_vector() == std::vector<char>{'x', 'y', 'z'});
+        test_assert(deser[2].to_vector() == std::vector<char>{'a', 'b', 'c'});
+        test_assert(deser[3].to_vector() == std::vector<char>{'a', 'b', 'c'});
+    };
+
+    test_case("dedup_buffer serialise_batch()") = [] {
+        using type = dynamic_array<char>;
+        std::vector<std::string_view> const sources{"abc", "xyz", "abc"};
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer};
+        auto const index = serialise_batch<type>(sources, dedup);
+
+        // The third object refers to the first's elements.
+        test_assert(buffer.span().size() == (8 + 3) + (8 + 3) + 8);
+        test_assert(index.size() == 3);
+        test_assert(index[2].size == 8);
+        auto const deser = deserialise<type>(buffer.span(), index[2].offset);
+        test_assert(deser.to_vector() == std::vector<char>{'a', 'b', 'c'});
+    };
+
+    test_case("dedup_buffer optional") = [] {
+        using type = pair<optional<dynamic_array<std::uint8_t>>, optional<dynamic_array<std::uint8_t>>>;
+        std::vector<std::uint8_t> const elements{1, 2, 3};
+        serialise_source<type> const source{elements, elements};
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer};
+        serialise(source, dedup);
+
+        // The second optional's value refers to the first's elements.
+        test_assert(buffer.span().size() == 8 + (8 + 3) + 8);
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.first().value().to_vector() == elements);
+        test_assert(deser.second().value().to_vector() == elements);
+    };
+
+    test_case("dedup_buffer nested blocks") = [] {
+        using type = dynamic_array<optional<dynamic_array<char>>>;
+        serialise_source<type> const source{{
+            std::string_view{"ab"}, std::string_view{"ab"}, std::string_view{"ab"}}};
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer};
+        serialise(source, dedup);
+
+        // The second string refers to the first string. The third optional's value is then identical to the second's.
+        test_assert(buffer.span().size() == 8 + 3 * 4 + (8 + 2) + 8);
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 3);
+        for (std::size_t i = 0; i < 3; ++i) {
+            test_assert(deser[i].value().to_vector() == std::vector<char>{'a', 'b'});
+        }
+    };
+
+    test_case("dedup_buffer reinitialise") = [] {
+        using type = dynamic_array<dynamic_array<char>>;
+        serialise_source<type> const source{{std::string_view{"abc"}, std::string_view{"abc"}}};
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer};
+        serialise(source, dedup);
+        std::vector<std::byte> const first{buffer.span().begin(), buffer.span().end()};
+        serialise(source, dedup);
+        test_assert(std::ranges::equal(buffer.span(), first));
+    };
+
+    test_case("dedup_buffer min_block_size") = [] {
+        using type = dynamic_array<dynamic_array<char>>;
+        serialise_source<type> const source{{std::string_view{"ab"}, std::string_view{"ab"}}};
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer, 3};
+        serialise(source, dedup);
+        test_assert(buffer.span().size() == 8 + 2 * 8 + 2 + 2);
+    };
+
+    test_case("dedup_buffer no duplicates") = [] {
+        using type = dynamic_array<dynamic_array<char>>;
+        serialise_source<type> const source{{std::string_view{"ab"}, std::string_view{"cd"}}};
+
+        basic_buffer expected_buffer;
+        serialise(source, expected_buffer);
+
+        basic_buffer buffer;
+        dedup_buffer dedup{buffer};
+        serialise(source, dedup);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+};
+}
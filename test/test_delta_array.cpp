@@ -0,0 +1,179 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/delta_array.hpp>
+#include <serialpp/dynamic_array.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block delta_array_tests = [] {
+
+    static_assert(variable_size_serialisable<delta_array<std::int64_t>>);
+    static_assert(size_precomputable<delta_array<std::int64_t>>);
+    static_assert(validatable<delta_array<std::uint32_t>>);
+    static_assert(fixed_data_size_v<delta_array<std::int64_t>> == 4 + 4);
+    static_assert(fixed_data_size_v<delta_array<std::int64_t, large_format>> == 8 + 8);
+
+    test_case("read_packed_bits() and write_packed_bits()") = [] {
+        std::array<std::byte, 16> bits{};
+        detail::write_packed_bits(bits, 0, 0b101, 3);
+        detail::write_packed_bits(bits, 3, 0x1FF, 9);
+        detail::write_packed_bits(bits, 12, 0xFEDCBA9876543210, 64);
+        test_assert(bits[0] == std::byte{0b1111'1101});
+        test_assert(bits[1] == std::byte{0x0F});
+        test_assert(detail::read_packed_bits(bits, 0, 3) == 0b101);
+        test_assert(detail::read_packed_bits(bits, 3, 9) == 0x1FF);
+        test_assert(detail::read_packed_bits(bits, 12, 64) == 0xFEDCBA9876543210);
+        test_assert(detail::read_packed_bits(bits, 5, 0) == 0);
+    };
+
+    test_case("serialise() delta_array") = [] {
+        using type = delta_array<std::uint16_t>;
+        serialise_source<type> const source{{1000, 1003, 1004, 1010}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 19> const expected_buffer{
+            0x04, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0xE8, 0x03,                 // First element
+            0x01, 0x00,                 // Minimum delta
+            0x03,                       // Bit width
+            0x00, 0x00, 0x00, 0x00,     // Packed deltas offset
+            0x42, 0x01                  // Packed deltas 2, 0, 5 (3, 1, 6 minus 1)
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 4);
+        test_assert(deser[0] == 1000);
+        test_assert(deser[2] == 1004);
+        test_assert(deser[3] == 1010);
+        test_assert(deser.to_vector() == std::vector<std::uint16_t>{1000, 1003, 1004, 1010});
+    };
+
+    test_case("serialise() delta_array empty") = [] {
+        using type = delta_array<std::int32_t>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 8> const expected_buffer{};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.empty());
+        test_assert(deser.to_vector().empty());
+    };
+
+    test_case("delta_array arithmetic sequence") = [] {
+        using type = delta_array<std::int64_t>;
+        std::vector<std::int64_t> elements;
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            elements.push_back(1'700'000'000'000'000 + i * 250);
+        }
+        serialise_source<type> const source{std::span<std::int64_t const>{elements}};
+        test_assert(variable_data_size<type>(source) == 8 * (8 + 8 + 1 + 4));
+
+        basic_buffer buffer;
+        serialise(source, buffer);
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.to_vector() == elements);
+        test_assert(deser[999] == elements[999]);
+    };
+
+    test_case("delta_array round trip") = [] {
+        using type = delta_array<std::int32_t>;
+        std::vector<std::int32_t> elements;
+        std::uint32_t state = 12345;
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < 700; ++i) {
+            state = state * 1'103'515'245u + 12345u;
+            // Mostly small changes, with occasional large jumps in either direction.
+            value += i % 97 == 0 ? state : (state >> 28) - 8;
+            elements.push_back(static_cast<std::int32_t>(value));
+        }
+        elements.push_back(std::numeric_limits<std::int32_t>::min());
+        elements.push_back(std::numeric_limits<std::int32_t>::max());
+        serialise_source<type> const source{std::vector<std::int32_t>{elements}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == elements.size());
+        test_assert(deser.to_vector<std::int64_t>() == std::vector<std::int64_t>(elements.begin(), elements.end()));
+        for (std::size_t i = 0; i < elements.size(); i += 37) {
+            test_assert(deser[i] == elements[i]);
+        }
+        test_assert(deser.at(elements.size() - 1) == elements.back());
+    };
+
+    test_case("delta_array in dynamic_array") = [] {
+        using type = dynamic_array<delta_array<std::uint8_t>>;
+        std::vector<std::uint8_t> const first{200, 100, 0, 255};
+        std::vector<std::uint8_t> const second{7};
+        serialise_source<type> const source{{std::span{first}, std::span{second}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser[0].to_vector() == first);
+        test_assert(deser[1].to_vector() == second);
+    };
+
+    test_case("deserialiser delta_array at() out of range") = [] {
+        using type = delta_array<std::uint32_t>;
+        serialise_source<type> const source{{1, 2}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert_throws<std::out_of_range>([&deser] {
+            (void)deser.at(2);
+        });
+    };
+
+    test_case("validate() delta_array packed deltas out of bounds") = [] {
+        std::array<unsigned char, 18> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x01, 0x00,                 // First element
+            0x00, 0x00,                 // Minimum delta
+            0x08,                       // Bit width
+            0x00, 0x00, 0x00, 0x00,     // Packed deltas offset
+            0x01                        // Packed deltas (should be 2 bytes)
+        };
+        using type = delta_array<std::uint16_t>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("validate() delta_array bit width too big") = [] {
+        std::array<unsigned char, 19> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x01, 0x00,                 // First element
+            0x00, 0x00,                 // Minimum delta
+            0x11,                       // Bit width
+            0x00, 0x00, 0x00, 0x00,     // Packed deltas offset
+            0x01, 0x02                  // Packed deltas
+        };
+        using type = delta_array<std::uint16_t>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+};
+}
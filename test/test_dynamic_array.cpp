@@ -1,8 +1,15 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <numeric>
 #include <ranges>
+#include <span>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -10,6 +17,7 @@
 #include <serialpp/buffers.hpp>
 #include <serialpp/common.hpp>
 #include <serialpp/dynamic_array.hpp>
+#include <serialpp/parallel.hpp>
 #include <serialpp/scalar.hpp>
 
 #include "helpers/buffer_utility.hpp"
@@ -18,6 +26,57 @@
 #include "helpers/test.hpp"
 
 
+namespace serialpp::test {
+
+    struct allocation_counts {
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+    };
+
+    template<typename T>
+    class counting_allocator {
+    public:
+        using value_type = T;
+
+        allocation_counts* counts;
+
+        explicit counting_allocator(allocation_counts& counts) noexcept :
+            counts{&counts}
+        {}
+
+        template<typename U>
+        counting_allocator(counting_allocator<U> const& other) noexcept :
+            counts{other.counts}
+        {}
+
+        [[nodiscard]]
+        T* allocate(std::size_t const n) {
+            ++counts->allocations;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* const p, std::size_t const n) noexcept {
+            ++counts->deallocations;
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(counting_allocator<U> const& other) const noexcept {
+            return counts == other.counts;
+        }
+    };
+
+}
+
+
+namespace serialpp {
+
+    template<>
+    inline constexpr std::size_t dynamic_array_inline_range_size<std::int8_t> = 64;
+
+}
+
+
 namespace serialpp::test {
 test_block dynamic_array_tests = [] {
 
@@ -31,11 +90,33 @@ test_block dynamic_array_tests = [] {
         });
     };
 
+    test_case("to_dynamic_array_size() large_format") = [] {
+        test_assert(detail::to_dynamic_array_size<large_format>(1'000'000'000'000ull) == 1'000'000'000'000ull);
+    };
+
 
     static_assert(variable_size_serialisable<dynamic_array<char>>);
     static_assert(variable_size_serialisable<dynamic_array<mock_serialisable<10, true>>>);
     static_assert(fixed_data_size_v<dynamic_array<std::int8_t>> == 4 + 4);
     static_assert(fixed_data_size_v<dynamic_array<mock_serialisable<1000>>> == 4 + 4);
+    static_assert(fixed_data_size_v<large_dynamic_array<std::int8_t>> == 8 + 8);
+    static_assert(
+        fixed_data_size_v<range_dynamic_array<std::uint8_t, std::vector<std::uint8_t>, large_format>> == 8 + 8);
+
+    static_assert(size_precomputable<dynamic_array<char>>);
+    static_assert(size_precomputable<dynamic_array<dynamic_array<char>>>);
+    static_assert(!size_precomputable<dynamic_array<mock_serialisable<10, true>>>);
+
+    static_assert(fixed_size_serialisable<range_dynamic_array<std::uint8_t, std::span<std::uint8_t const>>> == false);
+    static_assert(size_precomputable<range_dynamic_array<std::uint8_t, std::span<std::uint8_t const>>>);
+    static_assert(validatable<range_dynamic_array<std::uint8_t, std::span<std::uint8_t const>>>);
+    static_assert(fixed_data_size_v<range_dynamic_array<std::uint8_t, std::vector<std::uint8_t>>> == 4 + 4);
+
+    static_assert(std::ranges::view<dynamic_array_view<std::uint16_t>>);
+    static_assert(std::ranges::random_access_range<dynamic_array_view<std::uint16_t>>);
+    static_assert(std::ranges::sized_range<dynamic_array_view<std::uint16_t>>);
+    static_assert(std::ranges::borrowed_range<dynamic_array_view<std::uint16_t>>);
+    static_assert(std::random_access_iterator<dynamic_array_view<dynamic_array<char>>::iterator>);
 
     test_case("serialise_source dynamic_array default construct") = [] {
         serialise_source<dynamic_array<int>> const source;
@@ -137,6 +218,55 @@ test_block dynamic_array_tests = [] {
         }();
     };
 
+    test_case("serialise_source dynamic_array allocator") = [] {
+        using type = dynamic_array<std::uint8_t>;
+        std::array<serialise_source<std::uint8_t>, 40> elements{};
+        std::ranges::fill(elements, serialise_source<std::uint8_t>{7});
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{elements}, expected_buffer);
+
+        allocation_counts counts;
+        {
+            // Owned array is too big to be stored inline.
+            serialise_source<type> const source{
+                std::allocator_arg, counting_allocator<std::byte>{counts}, std::move(elements)};
+            test_assert(counts.allocations == 1);
+            basic_buffer buffer;
+            serialise(source, buffer);
+            test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+        }
+        test_assert(counts.allocations == 1);
+        test_assert(counts.deallocations == 1);
+    };
+
+    test_case("serialise_source dynamic_array allocator small range") = [] {
+        std::vector<std::uint8_t> const elements{1, 2, 3};
+        allocation_counts counts;
+        serialise_source<dynamic_array<std::uint8_t>> const source{
+            std::allocator_arg, counting_allocator<std::byte>{counts}, elements};
+        test_assert(counts.allocations == 0);
+    };
+
+    test_case("serialise_source dynamic_array custom inline range size") = [] {
+        static_assert(sizeof(serialise_source<dynamic_array<std::int8_t>>)
+            > sizeof(serialise_source<dynamic_array<std::uint8_t>>));
+
+        using type = dynamic_array<std::int8_t>;
+        std::array<serialise_source<std::int8_t>, 40> elements{};
+        std::ranges::fill(elements, serialise_source<std::int8_t>{-3});
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{elements}, expected_buffer);
+
+        allocation_counts counts;
+        // Owned array fits in the enlarged inline storage.
+        serialise_source<type> const source{
+            std::allocator_arg, counting_allocator<std::byte>{counts}, std::move(elements)};
+        test_assert(counts.allocations == 0);
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
     test_case("serialiser dynamic_array empty") = [] {
         using type = dynamic_array<std::uint64_t>;
         basic_buffer buffer;
@@ -275,6 +405,328 @@ test_block dynamic_array_tests = [] {
     //     }();
     // };
 
+    test_case("serialiser dynamic_array scalar contiguous range") = [] {
+        using type = dynamic_array<std::int16_t>;
+        basic_buffer buffer;
+        buffer.initialise(8);
+        std::vector<std::int16_t> const elements{-2, 12'345, 0, -32'768};
+        serialise_source<type> const source{elements};
+        serialiser<type>::serialise(source, buffer, 0);
+
+        std::array<unsigned char, 16> const expected_buffer{
+            0x04, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0xFE, 0xFF,                 // Elements
+            0x39, 0x30,
+            0x00, 0x00,
+            0x00, 0x80
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+    };
+
+    test_case("serialiser dynamic_array floating point contiguous range") = [] {
+        using type = dynamic_array<double>;
+        basic_buffer buffer;
+        buffer.initialise(8);
+        std::vector<serialise_source<double>> const elements{0.0, -123456.0};
+        serialise_source<type> const source{elements};
+        serialiser<type>::serialise(source, buffer, 0);
+
+        std::array<unsigned char, 24> const expected_buffer{
+            0x02, 0x00, 0x00, 0x00,                             // Size
+            0x08, 0x00, 0x00, 0x00,                             // Offset
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // Elements
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0xFE, 0xC0
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+    };
+
+    test_case("serialiser dynamic_array parallel fixed size elements") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::deque<std::uint32_t> elements(10'000);
+        std::iota(elements.begin(), elements.end(), 1'000'000u);
+
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{elements}, expected_buffer);
+        basic_buffer buffer;
+        serialise(parallel_options{.thread_count = 4, .min_elements_per_thread = 1000},
+            serialise_source<type>{elements}, buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("serialiser dynamic_array parallel variable size elements") = [] {
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        std::vector<std::vector<std::uint16_t>> elements(5'000);
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            elements[i].resize(i % 7, static_cast<std::uint16_t>(i));
+        }
+        std::vector<serialise_source<dynamic_array<std::uint16_t>>> element_sources;
+        for (auto const& element : elements) {
+            element_sources.emplace_back(element);
+        }
+
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{element_sources}, expected_buffer);
+        basic_buffer buffer;
+        serialise(parallel_options{.thread_count = 3, .min_elements_per_thread = 100},
+            serialise_source<type>{element_sources}, buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("parallel_for_each() dynamic_array") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::vector<std::uint32_t> elements(10'000);
+        std::iota(elements.begin(), elements.end(), 1u);
+        basic_buffer buffer;
+        serialise(serialise_source<type>{elements}, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        std::atomic<std::uint64_t> sum = 0;
+        std::atomic<std::size_t> count = 0;
+        parallel_for_each(deser, [&sum, &count](std::uint32_t const element) {
+            sum += element;
+            ++count;
+        }, parallel_options{.thread_count = 4, .min_elements_per_thread = 100});
+        test_assert(count == 10'000);
+        test_assert(sum == 50'005'000);
+    };
+
+    test_case("parallel_reduce() dynamic_array") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::vector<std::uint32_t> elements(10'000);
+        std::iota(elements.begin(), elements.end(), 1u);
+        basic_buffer buffer;
+        serialise(serialise_source<type>{elements}, buffer);
+
+        auto const deser = deserialise<type>(buffer.span());
+        auto const sum = parallel_reduce(deser, std::uint64_t{7}, std::plus<>{},
+            [](std::uint32_t const element) { return std::uint64_t{element}; },
+            parallel_options{.thread_count = 4, .min_elements_per_thread = 100});
+        test_assert(sum == 50'005'007);
+    };
+
+    test_case("parallel_reduce() dynamic_array empty") = [] {
+        std::array<unsigned char, 8> const buffer{};
+        auto const deser = deserialise<dynamic_array<std::uint32_t>>(as_const_bytes_span(buffer));
+        auto const sum = parallel_reduce(deser, 42, std::plus<>{}, [](std::uint32_t const element) {
+            return static_cast<int>(element);
+        });
+        test_assert(sum == 42);
+    };
+
+    test_case("validate() dynamic_array parallel") = [] {
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        std::vector<std::vector<std::uint16_t>> elements(5'000);
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            elements[i].resize(i % 5, static_cast<std::uint16_t>(i));
+        }
+        std::vector<serialise_source<dynamic_array<std::uint16_t>>> element_sources;
+        for (auto const& element : elements) {
+            element_sources.emplace_back(element);
+        }
+        basic_buffer buffer;
+        serialise(serialise_source<type>{element_sources}, buffer);
+        parallel_options const parallel{.thread_count = 4, .min_elements_per_thread = 100};
+
+        auto const deser = validate<type>(parallel, buffer.span());
+        test_assert(deser.size() == 5'000);
+        test_assert(deser[4'999].size() == 4);
+
+        // Make the last inner array's size too big for the buffer.
+        buffer.span()[8 + 8 * 4'999] = std::byte{0xFF};
+        test_assert_throws<buffer_bounds_error>([&buffer, &parallel] {
+            (void)validate<type>(parallel, buffer.span());
+        });
+    };
+
+    test_case("parallel_options slice_count()") = [] {
+        parallel_options const options{.thread_count = 8, .min_elements_per_thread = 100};
+        test_assert(options.slice_count(0) == 1);
+        test_assert(options.slice_count(199) == 1);
+        test_assert(options.slice_count(200) == 2);
+        test_assert(options.slice_count(100'000) == 8);
+    };
+
+    test_case("serialiser dynamic_array variable_data_size() empty") = [] {
+        using type = dynamic_array<std::uint64_t>;
+        test_assert(serialiser<type>::variable_data_size(serialise_source<type>{}) == 0);
+    };
+
+    test_case("serialiser dynamic_array variable_data_size() scalar range") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::vector<long long> const elements{23, 67'456'534, 0, 345'342, 456, 4356, 3, 7567, 2'532'865'138};
+        serialise_source<type> const source{elements};
+        test_assert(serialiser<type>::variable_data_size(source) == 9 * 4);
+    };
+
+    test_case("serialiser dynamic_array variable_data_size() scalar non-contiguous range") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::deque<std::uint32_t> elements(10'000);
+        std::iota(elements.begin(), elements.end(), 0u);
+        serialise_source<type> const source{elements};
+        test_assert(serialiser<type>::variable_data_size(source) == 10'000 * 4);
+    };
+
+    test_case("serialiser range_dynamic_array same as dynamic_array") = [] {
+        std::vector<std::uint32_t> const elements{23, 67'456'534, 0, 345'342, 456, 4356};
+
+        basic_buffer expected_buffer;
+        serialise(serialise_source<dynamic_array<std::uint32_t>>{elements}, expected_buffer);
+
+        using type = range_dynamic_array<std::uint32_t, std::span<std::uint32_t const>>;
+        serialise_source<type> const source{elements};
+        test_assert(variable_data_size<type>(source) == 6 * 4);
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.to_vector() == elements);
+    };
+
+    test_case("serialiser range_dynamic_array variable size elements") = [] {
+        std::vector<std::vector<std::uint16_t>> const elements{{1, 2, 3}, {}, {4}, {5, 6, 7, 8, 9}};
+
+        basic_buffer expected_buffer;
+        {
+            std::vector<serialise_source<dynamic_array<std::uint16_t>>> sources;
+            for (auto const& element : elements) {
+                sources.emplace_back(element);
+            }
+            serialise(serialise_source<dynamic_array<dynamic_array<std::uint16_t>>>{sources}, expected_buffer);
+        }
+
+        using type = range_dynamic_array<dynamic_array<std::uint16_t>, std::vector<std::vector<std::uint16_t>>>;
+        serialise_source<type> const source{elements};
+        test_assert(serialised_size<type>(source) == expected_buffer.span().size());
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("serialiser range_dynamic_array empty") = [] {
+        using type = range_dynamic_array<std::uint64_t, std::vector<std::uint64_t>>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        basic_buffer expected_buffer;
+        serialise(serialise_source<dynamic_array<std::uint64_t>>{}, expected_buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("dynamic_array_builder empty") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        basic_buffer buffer;
+        dynamic_array_builder<std::uint32_t, basic_buffer> builder{buffer};
+        builder.finish();
+
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{}, expected_buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("dynamic_array_builder fixed size elements") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::vector<std::uint32_t> const elements{23, 67'456'534, 0, 345'342, 456, 4356};
+        basic_buffer buffer;
+        dynamic_array_builder<std::uint32_t, basic_buffer> builder{buffer};
+        for (auto const element : elements) {
+            builder.push_back(element);
+        }
+        test_assert(builder.size() == elements.size());
+        builder.finish();
+
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{elements}, expected_buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("dynamic_array_builder variable size elements") = [] {
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        std::vector<std::vector<std::uint16_t>> const elements{{1, 2, 3}, {}, {4}, {5, 6, 7, 8, 9}};
+        basic_buffer buffer;
+        dynamic_array_builder<dynamic_array<std::uint16_t>, basic_buffer> builder{buffer};
+        for (auto const& element : elements) {
+            builder.push_back(serialise_source<dynamic_array<std::uint16_t>>{element});
+        }
+        builder.finish();
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == elements.size());
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            test_assert(deser[i].to_vector() == elements[i]);
+        }
+    };
+
+    test_case("dynamic_array_builder variable size elements reserved") = [] {
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        std::vector<std::vector<std::uint16_t>> const elements{{1, 2, 3}, {}, {4}, {5, 6, 7, 8, 9}};
+        basic_buffer buffer;
+        dynamic_array_builder<dynamic_array<std::uint16_t>, basic_buffer> builder{buffer};
+        builder.reserve(elements.size());
+        for (auto const& element : elements) {
+            builder.push_back(serialise_source<dynamic_array<std::uint16_t>>{element});
+        }
+        builder.finish();
+
+        // Fixed data is serialised in place, so the result is the same as serialising all elements at once.
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{elements}, expected_buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("dynamic_array_builder variable size elements more than reserved") = [] {
+        using type = dynamic_array<dynamic_array<std::uint16_t>>;
+        std::vector<std::vector<std::uint16_t>> const elements{{1, 2, 3}, {}, {4}, {5, 6, 7, 8, 9}, {10, 11}};
+        basic_buffer buffer;
+        dynamic_array_builder<dynamic_array<std::uint16_t>, basic_buffer> builder{buffer};
+        builder.reserve(2);
+        for (auto const& element : elements) {
+            builder.push_back(serialise_source<dynamic_array<std::uint16_t>>{element});
+        }
+        builder.finish();
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == elements.size());
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            test_assert(deser[i].to_vector() == elements[i]);
+        }
+    };
+
+    test_case("dynamic_array_builder fewer than reserved") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        std::vector<std::uint32_t> const elements{23, 67'456'534, 0};
+        basic_buffer buffer;
+        dynamic_array_builder<std::uint32_t, basic_buffer> builder{buffer};
+        builder.reserve(10);
+        for (auto const element : elements) {
+            builder.push_back(element);
+        }
+        builder.finish();
+
+        // Unused slots are truncated away.
+        basic_buffer expected_buffer;
+        serialise(serialise_source<type>{elements}, expected_buffer);
+        test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+    };
+
+    test_case("dynamic_array_builder nested") = [] {
+        // dynamic_array which is a subobject of some parent object.
+        basic_buffer buffer;
+        buffer.initialise(4 + fixed_data_size_v<dynamic_array<std::uint64_t>>);
+        serialise<std::uint32_t>(1234u, buffer, 0);
+        dynamic_array_builder<std::uint64_t, basic_buffer> builder{buffer, 4};
+        builder.push_back(10);
+        builder.push_back(20);
+        builder.push_back(30);
+        builder.finish();
+
+        test_assert(deserialise<std::uint32_t>(buffer.span(), 0) == 1234u);
+        auto const deser = validate<dynamic_array<std::uint64_t>>(buffer.span(), 4);
+        test_assert(deser.to_vector() == std::vector<std::uint64_t>{10, 20, 30});
+    };
+
     test_case("deserialiser dynamic_array empty") = [] {
         std::array<unsigned char, 8> const buffer{
             0x00, 0x00, 0x00, 0x00,     // Size
@@ -378,6 +830,242 @@ test_block dynamic_array_tests = [] {
         }();
     };
 
+    test_case("deserialiser dynamic_array elements_span() empty") = [] {
+        std::array<unsigned char, 8> const buffer{
+            0x00, 0x00, 0x00, 0x00,     // Size
+            0xFF, 0x00, 0x00, 0x00      // Offset (not significant)
+        };
+        using type = dynamic_array<std::int32_t>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        auto const span = deser.elements_span();
+        test_assert(span.has_value());
+        test_assert(span->empty());
+    };
+
+    test_case("deserialiser dynamic_array elements_span() aligned") = [] {
+        alignas(8) std::array<unsigned char, 20> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x17, 0x00, 0x00, 0x00,     // Elements
+            0x16, 0x4E, 0x05, 0x04,
+            0x72, 0x74, 0xF8, 0x96
+        };
+        using type = dynamic_array<std::uint32_t>;
+        auto const buffer_span = as_const_bytes_span(buffer);
+        deserialiser<type> const deser{buffer_span, 0};
+        std::array<std::uint32_t, 3> const expected_elements{23, 67'456'534, 2'532'865'138};
+
+        auto const span = deser.elements_span();
+        std::vector<std::uint32_t> fallback_storage;
+        auto const fallback_span = deser.elements_span(fallback_storage);
+        if constexpr (std::endian::native == std::endian::little) {
+            test_assert(span.has_value());
+            test_assert(static_cast<void const*>(span->data()) == buffer_span.data() + 8);
+            test_assert(std::ranges::equal(*span, expected_elements));
+            test_assert(fallback_storage.empty());
+            test_assert(fallback_span.data() == span->data());
+        }
+        else {
+            test_assert(!span.has_value());
+        }
+        test_assert(std::ranges::equal(fallback_span, expected_elements));
+    };
+
+    test_case("deserialiser dynamic_array elements_span() misaligned") = [] {
+        alignas(8) std::array<unsigned char, 21> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x09, 0x00, 0x00, 0x00,     // Offset
+            0x01,                       // Dummy padding
+            0x17, 0x00, 0x00, 0x00,     // Elements
+            0x16, 0x4E, 0x05, 0x04,
+            0x72, 0x74, 0xF8, 0x96
+        };
+        using type = dynamic_array<std::uint32_t>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        test_assert(!deser.elements_span().has_value());
+
+        std::vector<std::uint32_t> fallback_storage;
+        auto const span = deser.elements_span(fallback_storage);
+        test_assert(span.data() == fallback_storage.data());
+        test_assert(std::ranges::equal(span, std::array<std::uint32_t, 3>{23, 67'456'534, 2'532'865'138}));
+    };
+
+    test_case("deserialiser dynamic_array elements_span() constexpr") = [] {
+        []() consteval {
+            std::array<unsigned char, 12> const buffer{
+                0x02, 0x00, 0x00, 0x00,     // Size
+                0x08, 0x00, 0x00, 0x00,     // Offset
+                0x74, 0xC1,                 // Elements
+                0x99, 0x5C
+            };
+            using type = dynamic_array<std::uint16_t>;
+            auto const buffer_bytes = uchar_array_to_bytes(buffer);
+            deserialiser<type> const deser{const_bytes_span{buffer_bytes}, 0};
+            test_assert(!deser.elements_span().has_value());
+            std::vector<std::uint16_t> fallback_storage;
+            test_assert(std::ranges::equal(deser.elements_span(fallback_storage), std::array{49524, 23705}));
+        }();
+    };
+
+    test_case("deserialiser dynamic_array elements_span() out of bounds") = [] {
+        alignas(8) std::array<unsigned char, 16> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x17, 0x00, 0x00, 0x00,     // Elements
+            0x16, 0x4E, 0x05, 0x04
+        };
+        using type = dynamic_array<std::uint32_t>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        test_assert_throws<buffer_bounds_error>([&deser] {
+            (void)deser.elements_span();
+        });
+        test_assert_throws<buffer_bounds_error>([&deser] {
+            std::vector<std::uint32_t> fallback_storage;
+            (void)deser.elements_span(fallback_storage);
+        });
+    };
+
+    test_case("deserialiser dynamic_array copy_to()") = [] {
+        std::array<unsigned char, 17> const buffer{
+            0x04, 0x00, 0x00, 0x00,     // Size
+            0x09, 0x00, 0x00, 0x00,     // Offset
+            0x01,                       // Dummy padding
+            0x0C, 0x00,                 // Elements
+            0x2D, 0x00,
+            0xD1, 0x01,
+            0x43, 0x60
+        };
+        using type = dynamic_array<std::uint16_t>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+
+        std::vector<std::uint16_t> output(6);
+        auto const written = deser.copy_to(std::span{output});
+        test_assert(written.data() == output.data());
+        test_assert(std::ranges::equal(written, std::array<std::uint16_t, 4>{12, 45, 465, 24643}));
+        test_assert(output[4] == 0 && output[5] == 0);
+
+        // Widening.
+        std::vector<std::int64_t> wide_output(4);
+        (void)deser.copy_to(std::span{wide_output});
+        test_assert(wide_output == std::vector<std::int64_t>{12, 45, 465, 24643});
+
+        test_assert(deser.to_vector() == std::vector<std::uint16_t>{12, 45, 465, 24643});
+        test_assert(deser.to_vector<std::uint32_t>() == std::vector<std::uint32_t>{12, 45, 465, 24643});
+
+        std::vector<std::uint16_t> small_output(3);
+        test_assert_throws<std::out_of_range>([&deser, &small_output] {
+            (void)deser.copy_to(std::span{small_output});
+        });
+    };
+
+    test_case("deserialiser dynamic_array copy_to() large") = [] {
+        using type = dynamic_array<float>;
+        std::vector<float> elements(5000);
+        std::iota(elements.begin(), elements.end(), -100.0f);
+        basic_buffer buffer;
+        serialise(serialise_source<type>{elements}, buffer);
+        deserialiser<type> const deser{buffer.span(), 0};
+
+        test_assert(deser.to_vector() == elements);
+
+        std::vector<double> wide_output(elements.size());
+        (void)deser.copy_to(std::span{wide_output});
+        test_assert(std::ranges::equal(wide_output, elements));
+    };
+
+    test_case("deserialiser dynamic_array copy_to() empty") = [] {
+        std::array<unsigned char, 8> const buffer{
+            0x00, 0x00, 0x00, 0x00,     // Size
+            0xFF, 0xFF, 0xFF, 0xFF      // Offset
+        };
+        using type = dynamic_array<bool>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        test_assert(deser.copy_to(std::span<bool>{}).empty());
+        test_assert(deser.to_vector().empty());
+    };
+
+    test_case("deserialiser dynamic_array copy_to() out of bounds") = [] {
+        std::array<unsigned char, 12> const buffer{
+            0x04, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x0C, 0x00,                 // Elements
+            0x2D, 0x00
+        };
+        using type = dynamic_array<std::uint16_t>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        test_assert_throws<buffer_bounds_error>([&deser] {
+            (void)deser.to_vector<std::uint32_t>();
+        });
+    };
+
+    test_case("deserialiser dynamic_array elements() view") = [] {
+        std::array<unsigned char, 24> const buffer{
+            0x05, 0x00, 0x00, 0x00,     // Size
+            0x0E, 0x00, 0x00, 0x00,     // Offset
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06,     // Dummy padding
+            0x74, 0xC1,     // Elements
+            0x99, 0x5C,
+            0x6E, 0x64,
+            0x36, 0xD1,
+            0x71, 0xDA
+        };
+        using type = dynamic_array<std::uint16_t>;
+        auto const elements = [&buffer] {
+            // View doesn't reference the deserialiser.
+            deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+            return deser.elements();
+        }();
+        test_assert(elements.size() == 5);
+        test_assert(elements[0] == 49524);
+        test_assert(elements[4] == 55921);
+        test_assert(elements.at(2) == 25710);
+        test_assert_throws<std::out_of_range>([&elements] {
+            (void)elements.at(5);
+        });
+
+        auto it = elements.begin();
+        test_assert(*it == 49524);
+        test_assert(it[3] == 53558);
+        it += 3;
+        test_assert(*it == 53558);
+        test_assert(*--it == 25710);
+        test_assert(*(it - 2) == 49524);
+        test_assert(elements.end() - it == 3);
+        test_assert(it < elements.end());
+        test_assert(std::ranges::equal(elements | std::views::reverse,
+            std::array<std::uint16_t, 5>{55921, 53558, 25710, 23705, 49524}));
+    };
+
+    test_case("deserialiser dynamic_array elements() iterator outlives view") = [] {
+        std::array<unsigned char, 14> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            0x74, 0xC1,     // Elements
+            0x99, 0x5C,
+            0x6E, 0x64
+        };
+        using type = dynamic_array<std::uint16_t>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        // The view is a temporary, which is destroyed before the iterator is used.
+        auto it = deser.elements().begin();
+        test_assert(*it == 49524);
+        ++it;
+        test_assert(*it == 23705);
+        test_assert(it[1] == 25710);
+    };
+
+    test_case("deserialiser dynamic_array elements() view zero size elements") = [] {
+        std::array<unsigned char, 8> const buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00      // Offset
+        };
+        using type = dynamic_array<null>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        auto const elements = deser.elements();
+        test_assert(std::ranges::distance(elements) == 3);
+        test_assert(elements.end() - elements.begin() == 3);
+    };
+
     test_case("deserialiser dynamic_array offset out of bounds") = [] {
         std::array<unsigned char, 24> const buffer{
             0x05, 0x00, 0x00, 0x00,     // Size
@@ -427,5 +1115,43 @@ test_block dynamic_array_tests = [] {
         });
     };
 
+    test_case("serialise() large_dynamic_array") = [] {
+        using type = large_dynamic_array<dynamic_array<std::uint8_t>>;
+        serialise_source<type> const source{{{{0x12, 0x34}}, {{0x56}}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 35> const expected_buffer{
+            0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // Size
+            0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // Offset
+            0x02, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,     // Element 0 size and offset
+            0x01, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,     // Element 1 size and offset
+            0x12, 0x34,                                         // Element 0 elements
+            0x56                                                // Element 1 elements
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 2);
+        test_assert(deser[0].to_vector() == std::vector<std::uint8_t>{0x12, 0x34});
+        test_assert(deser[1].to_vector() == std::vector<std::uint8_t>{0x56});
+        (void)validate<type>(buffer.span());
+    };
+
+    test_case("dynamic_array_builder large_format") = [] {
+        basic_buffer buffer;
+        dynamic_array_builder<std::uint16_t, basic_buffer, large_format> builder{buffer};
+        builder.push_back(0x1234);
+        builder.push_back(0x5678);
+        builder.finish();
+
+        std::array<unsigned char, 20> const expected_buffer{
+            0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // Size
+            0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // Offset
+            0x34, 0x12, 0x78, 0x56                              // Elements
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+    };
+
 };
 }
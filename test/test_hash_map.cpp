@@ -0,0 +1,208 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/hash_map.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block hash_map_tests = [] {
+
+    static_assert(variable_size_serialisable<hash_map<std::int32_t, double>>);
+    static_assert(size_precomputable<hash_map<std::int32_t, dynamic_array<std::uint8_t>>>);
+    static_assert(validatable<hash_map<std::int32_t, dynamic_array<std::uint8_t>>>);
+    static_assert(fixed_data_size_v<hash_map<std::int32_t, double>> == 4 + 4 + 4 + 4 + 4);
+    static_assert(fixed_data_size_v<large_hash_map<std::int32_t, double>> == 8 + 8 + 8 + 8 + 8);
+
+    static_assert(std::ranges::view<hash_map_view<std::int32_t, double>>);
+    static_assert(std::ranges::forward_range<hash_map_view<std::int32_t, double>>);
+    static_assert(std::ranges::borrowed_range<hash_map_view<std::int32_t, double>>);
+
+    static_assert(detail::hash_map_slot_count(0) == 0);
+    static_assert(detail::hash_map_slot_count(1) == 8);
+    static_assert(detail::hash_map_slot_count(7) == 8);
+    static_assert(detail::hash_map_slot_count(8) == 16);
+    static_assert(detail::hash_map_slot_count(14) == 16);
+    static_assert(detail::hash_map_slot_count(15) == 32);
+
+    static_assert(stable_hash<std::int8_t>{}(-1) == stable_hash<std::int64_t>{}(-1));
+    static_assert(stable_hash<std::uint16_t>{}(300) == stable_hash<std::uint64_t>{}(300));
+    static_assert(stable_hash<std::uint64_t>{}(0) == 0);
+    static_assert(stable_hash<std::uint64_t>{}(1) == 0xB456'BCFC'34C2'CB2Cull);
+
+    test_case("match_hash_map_group()") = [] {
+        std::array<std::byte, 8> const control{
+            std::byte{0x12}, std::byte{0x80}, std::byte{0x34}, std::byte{0x12},
+            std::byte{0x80}, std::byte{0x00}, std::byte{0x7F}, std::byte{0x12}
+        };
+        auto const group = detail::load_hash_map_group(control, 0);
+        test_assert(detail::match_hash_map_group(group, 0x12) == 0x8000'0000'8000'0080ull);
+        test_assert(detail::match_hash_map_group(group, 0x7F) == 0x0080'0000'0000'0000ull);
+        test_assert(detail::match_hash_map_group_empty(group) == 0x0000'0080'0000'8000ull);
+    };
+
+    test_case("serialise() hash_map") = [] {
+        using type = hash_map<std::uint16_t, std::uint8_t>;
+        serialise_source<type> const source{{{300, 3}, {10, 1}, {200, 2}}};
+        test_assert(source.slot_count() == 8);
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(buffer.span().size() == 20 + 15 + 8 * 2 + 8 * 1);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == 3);
+        test_assert(deser.slot_count() == 8);
+        test_assert(deser.find(200) == 2);
+        test_assert(!deser.find(100));
+        test_assert(deser.contains(10));
+        test_assert(!deser.contains(301));
+        test_assert(deser.at(300) == 3);
+        test_assert_throws<std::out_of_range>([&deser] {
+            (void)deser.at(0);
+        });
+    };
+
+    test_case("serialise() hash_map empty") = [] {
+        using type = hash_map<std::int32_t, double>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 20> const expected_buffer{};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.empty());
+        test_assert(!deser.find(0));
+        test_assert(deser.entries().begin() == deser.entries().end());
+    };
+
+    test_case("hash_map many entries") = [] {
+        using type = hash_map<std::uint64_t, std::int64_t>;
+        std::unordered_map<std::uint64_t, std::int64_t> entries;
+        for (std::uint64_t i = 0; i < 5000; ++i) {
+            entries.emplace(i * 0x9E37'79B9'7F4A'7C15ull, -static_cast<std::int64_t>(i));
+        }
+        serialise_source<type> const source{entries};
+        test_assert(source.slot_count() == 8192);
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(variable_data_size<type>(source) == buffer.span().size() - fixed_data_size_v<type>);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == 5000);
+        for (auto const& [key, value] : entries) {
+            test_assert(deser.find(key) == value);
+        }
+        for (std::uint64_t i = 1; i < 1000; ++i) {
+            test_assert(!deser.contains(i));
+        }
+
+        std::map<std::uint64_t, std::int64_t> iterated;
+        for (auto const [key, value] : deser.entries()) {
+            iterated.emplace(key, value);
+        }
+        test_assert(iterated == std::map<std::uint64_t, std::int64_t>(entries.begin(), entries.end()));
+    };
+
+    test_case("hash_map lookup with different key type") = [] {
+        using type = hash_map<std::int16_t, std::uint8_t>;
+        serialise_source<type> const source{{{-5, 1}, {1000, 2}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.find(std::int64_t{-5}) == 1);
+        test_assert(deser.entries().find(std::int64_t{1000}).key() == 1000);
+    };
+
+    test_case("hash_map_view find() iterator outlives view") = [] {
+        using type = hash_map<std::int32_t, std::int32_t>;
+        serialise_source<type> const source{{{1, 10}, {2, 20}, {3, 30}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        // The view is a temporary, which is destroyed before the iterator is used.
+        auto it = deser.entries().find(2);
+        test_assert(it.key() == 2);
+        test_assert(it.value() == 20);
+        auto const end = deser.entries().end();
+        test_assert(std::ranges::distance(it, end) >= 1);
+    };
+
+    test_case("serialise_source hash_map duplicate keys") = [] {
+        using type = hash_map<std::int32_t, std::int32_t>;
+        test_assert_throws<std::invalid_argument>([] {
+            serialise_source<type> const source{{{1, 1}, {2, 2}, {1, 3}}};
+        });
+    };
+
+    test_case("hash_map with variable size values") = [] {
+        using type = hash_map<std::uint32_t, dynamic_array<std::uint8_t>>;
+        using bytes = serialise_source<dynamic_array<std::uint8_t>>;
+        serialise_source<type> const source{{{7, bytes{{1, 2}}}, {4, bytes{{3}}}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+        test_assert(variable_data_size<type>(source) == 15 + 8 * 4 + 8 * 8 + 3);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.at(4).to_vector() == std::vector<std::uint8_t>{3});
+        test_assert(deser.at(7).to_vector() == std::vector<std::uint8_t>{1, 2});
+    };
+
+    test_case("validate() hash_map invalid slot count") = [] {
+        std::array<unsigned char, 20> const buffer{
+            0x01, 0x00, 0x00, 0x00,     // Size
+            0x06, 0x00, 0x00, 0x00,     // Slot count
+            0x00, 0x00, 0x00, 0x00,     // Control bytes offset
+            0x00, 0x00, 0x00, 0x00,     // Keys offset
+            0x00, 0x00, 0x00, 0x00      // Values offset
+        };
+        using type = hash_map<std::uint8_t, std::uint8_t>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("validate() hash_map size doesn't match control bytes") = [] {
+        using type = hash_map<std::uint8_t, std::uint8_t>;
+        serialise_source<type> const source{{{1, 2}, {3, 4}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+        buffer.span()[0] = std::byte{0x03};
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(buffer.span());
+        });
+    };
+
+    test_case("validate() hash_map control bytes out of bounds") = [] {
+        std::array<unsigned char, 30> const buffer{
+            0x01, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Slot count
+            0x14, 0x00, 0x00, 0x00,     // Control bytes offset
+            0x00, 0x00, 0x00, 0x00,     // Keys offset
+            0x00, 0x00, 0x00, 0x00,     // Values offset
+            0x80, 0x80, 0x80, 0x80,     // Control bytes (should be 15 bytes)
+            0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80
+        };
+        using type = hash_map<std::uint8_t, std::uint8_t>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)deserialise<type>(as_const_bytes_span(buffer)).find(1);
+        });
+    };
+
+};
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/mmap_buffer.hpp>
+#include <serialpp/scalar.hpp>
+
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+
+    // Unique path in the temporary directory. The file (if created) is removed when this object is destroyed.
+    class temp_file {
+    public:
+        temp_file() :
+            _path{std::filesystem::temp_directory_path()
+                / std::format("serialpp_test_mmap_buffer_{}_{}.bin", ::getpid(), _next_id++)}
+        {}
+
+        temp_file(temp_file const&) = delete;
+        temp_file& operator=(temp_file const&) = delete;
+
+        ~temp_file() {
+            std::error_code error;
+            std::filesystem::remove(_path, error);
+        }
+
+        [[nodiscard]]
+        std::filesystem::path const& path() const noexcept {
+            return _path;
+        }
+
+    private:
+        static inline std::atomic<std::uint64_t> _next_id = 0;
+
+        std::filesystem::path _path;
+    };
+
+
+test_block mmap_buffer_tests = [] {
+
+    static_assert(serialise_buffer<mmap_file_buffer>);
+    static_assert(serialise_buffer<reserved_buffer>);
+    static_assert(reserved_buffer::default_max_size == std::min<std::uint64_t>(std::uint64_t{1} << 33, SIZE_MAX));
+
+    test_case("mmap_file_buffer construct") = [] {
+        temp_file const file;
+        mmap_file_buffer buffer{file.path(), 6493};
+        test_assert(buffer.capacity() == 6493);
+        test_assert(buffer.span().empty());
+        test_assert(std::filesystem::file_size(file.path()) == 6493);
+    };
+
+    test_case("mmap_file_buffer construct invalid path") = [] {
+        test_assert_throws<std::system_error>([] {
+            mmap_file_buffer buffer{"/nonexistent_directory/file.bin"};
+        });
+    };
+
+    test_case("mmap_file_buffer initialise() exceed capacity") = [] {
+        temp_file const file;
+        mmap_file_buffer buffer{file.path(), 100};
+        buffer.initialise(200);
+        test_assert(buffer.capacity() >= 200);
+        test_assert(buffer.span().size() == 200);
+    };
+
+    test_case("mmap_file_buffer extend() exceed capacity") = [] {
+        temp_file const file;
+        mmap_file_buffer buffer{file.path(), 150};
+        buffer.initialise(100);
+        mutable_bytes_span const span1 = buffer.span();
+        span1[0] = std::byte{10};
+        span1[99] = std::byte{42};
+        buffer.extend(100'000);
+
+        test_assert(buffer.capacity() >= 100'100);
+        mutable_bytes_span const span2 = buffer.span();
+        test_assert(span2.size() == 100'100);
+        test_assert(span2[0] == std::byte{10});
+        test_assert(span2[99] == std::byte{42});
+        span2[100'099] = std::byte{7};
+    };
+
+    test_case("mmap_file_buffer sync()") = [] {
+        temp_file const file;
+        mmap_file_buffer buffer{file.path(), 1000};
+        buffer.initialise(10);
+        buffer.span()[9] = std::byte{33};
+        buffer.sync();
+        test_assert(std::filesystem::file_size(file.path()) == 10);
+        test_assert(buffer.span().size() == 10);
+        test_assert(buffer.span()[9] == std::byte{33});
+        buffer.extend(20);
+        test_assert(buffer.span()[9] == std::byte{33});
+    };
+
+    test_case("mmap_file_buffer move assign") = [] {
+        temp_file const file;
+        mmap_file_buffer buffer1{file.path(), 100};
+        buffer1.initialise(50);
+        buffer1.span()[0] = std::byte{10};
+        temp_file const file2;
+        mmap_file_buffer buffer2{file2.path(), 100};
+        buffer2 = std::move(buffer1);
+        test_assert(buffer2.span().size() == 50);
+        test_assert(buffer2.span()[0] == std::byte{10});
+    };
+
+    test_case("mmap_file_buffer and mmap_file_view round trip") = [] {
+        temp_file const file;
+        using type = dynamic_array<std::uint32_t>;
+        {
+            mmap_file_buffer buffer{file.path(), 0};
+            serialise_source<type> const source{{123'456u, 789u, 4'000'000'000u}};
+            serialise(source, buffer);
+            test_assert(buffer.span().size() == 20);
+        }
+        test_assert(std::filesystem::file_size(file.path()) == 20);
+
+        mmap_file_view const view{file.path()};
+        test_assert(view.span().size() == 20);
+        auto const deser = deserialise<type>(view.span());
+        test_assert(deser.size() == 3);
+        test_assert(deser[0] == 123'456u);
+        test_assert(deser[1] == 789u);
+        test_assert(deser[2] == 4'000'000'000u);
+    };
+
+    test_case("mmap_file_view empty file") = [] {
+        temp_file const file;
+        {
+            mmap_file_buffer buffer{file.path(), 0};
+        }
+        mmap_file_view const view{file.path()};
+        test_assert(view.span().empty());
+    };
+
+    test_case("mmap_file_view nonexistent file") = [] {
+        test_assert_throws<std::system_error>([] {
+            mmap_file_view view{"/nonexistent_directory/file.bin"};
+        });
+    };
+
+    test_case("reserved_buffer construct") = [] {
+        reserved_buffer buffer{1 << 20};
+        test_assert(buffer.max_size() == 1 << 20);
+        test_assert(buffer.capacity() == 0);
+        test_assert(buffer.span().empty());
+    };
+
+    test_case("reserved_buffer extend() never moves") = [] {
+        reserved_buffer buffer;
+        buffer.initialise(100);
+        mutable_bytes_span const span1 = buffer.span();
+        span1[0] = std::byte{10};
+        span1[99] = std::byte{42};
+        buffer.extend(10'000'000);
+
+        test_assert(buffer.capacity() >= 10'000'100);
+        mutable_bytes_span const span2 = buffer.span();
+        test_assert(span2.data() == span1.data());
+        test_assert(span2.size() == 10'000'100);
+        test_assert(span2[0] == std::byte{10});
+        test_assert(span2[99] == std::byte{42});
+        span2[10'000'099] = std::byte{7};
+    };
+
+    test_case("reserved_buffer initialise() exceed max size") = [] {
+        reserved_buffer buffer{1 << 20};
+        test_assert_throws<std::bad_alloc>([&buffer] {
+            buffer.initialise((1 << 20) + 1);
+        });
+    };
+
+    test_case("reserved_buffer extend() exceed max size") = [] {
+        reserved_buffer buffer{1 << 20};
+        buffer.initialise(1000);
+        test_assert_throws<std::bad_alloc>([&buffer] {
+            buffer.extend(1 << 20);
+        });
+        test_assert(buffer.span().size() == 1000);
+        buffer.extend((1 << 20) - 1000);
+        test_assert(buffer.span().size() == 1 << 20);
+    };
+
+    test_case("reserved_buffer serialise()") = [] {
+        using type = dynamic_array<std::uint32_t>;
+        reserved_buffer buffer;
+        serialise_source<type> const source{{123'456u, 789u, 4'000'000'000u}};
+        serialise(source, buffer);
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 3);
+        test_assert(deser[2] == 4'000'000'000u);
+    };
+
+};
+}
@@ -21,9 +21,13 @@ test_block optional_tests = [] {
     static_assert(fixed_data_size_v<optional<char>> == 4);
     static_assert(fixed_data_size_v<optional<std::uint64_t>> == 4);
     static_assert(fixed_data_size_v<optional<mock_serialisable<10000>>> == 4);
+    static_assert(fixed_data_size_v<large_optional<char>> == 8);
 
     static_assert(std::semiregular<serialise_source<optional<long>>>);
 
+    static_assert(size_precomputable<optional<int>>);
+    static_assert(!size_precomputable<optional<mock_serialisable<10, true>>>);
+
     test_case("serialiser optional empty") = [] {
         basic_buffer buffer;
         serialise_source<optional<std::int32_t>> const source;
@@ -66,6 +70,12 @@ test_block optional_tests = [] {
         test_assert(buffer_equal(buffer, expected_buffer));
     };
 
+    test_case("serialiser optional variable_data_size()") = [] {
+        using type = optional<std::int64_t>;
+        test_assert(serialiser<type>::variable_data_size(serialise_source<type>{}) == 0);
+        test_assert(serialiser<type>::variable_data_size(serialise_source<type>{-54'321}) == 8);
+    };
+
     test_case("deserialiser optional empty") = [] {
         std::array<unsigned char, 4> const buffer{0x00, 0x00, 0x00, 0x00};
         using type = optional<std::uint64_t>;
@@ -127,5 +137,22 @@ test_block optional_tests = [] {
         });
     };
 
+    test_case("serialise() large_optional") = [] {
+        using type = large_optional<std::uint16_t>;
+        serialise_source<type> const source{0x1234};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 10> const expected_buffer{
+            0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // optional value offset
+            0x34, 0x12                                          // optional value
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.has_value());
+        test_assert(deser.value() == 0x1234);
+    };
+
 };
 }
@@ -0,0 +1,190 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/pod_layout.hpp>
+#include <serialpp/record.hpp>
+#include <serialpp/scalar.hpp>
+#include <serialpp/static_array.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+
+    struct pod_test_inner_record : record<
+        field<"x", std::int32_t>,
+        field<"y", std::int32_t>
+    > {};
+
+    struct pod_test_record : record<
+        field<"timestamp", std::uint64_t>,
+        field<"price", double>,
+        field<"quantity", std::uint32_t>,
+        field<"flags", static_array<std::uint8_t, 4>>,
+        field<"position", pod_test_inner_record>
+    > {};
+
+    struct pod_test_inner_struct {
+        std::int32_t x;
+        std::int32_t y;
+    };
+
+    struct pod_test_struct {
+        std::uint64_t timestamp;
+        double price;
+        std::uint32_t quantity;
+        std::array<std::uint8_t, 4> flags;
+        pod_test_inner_struct position;
+    };
+
+    struct pod_test_bool_record : record<
+        field<"a", std::uint32_t>,
+        field<"b", bool>
+    > {};
+
+    struct pod_test_bool_struct {
+        std::uint32_t a;
+        bool b;
+    };
+
+    struct pod_test_dynamic_record : record<
+        field<"a", dynamic_array<std::uint32_t>>
+    > {};
+
+    struct pod_test_dynamic_struct {
+        std::uint32_t count;
+        std::uint32_t offset;
+    };
+
+    struct pod_test_padded_struct {
+        std::uint64_t timestamp;
+        double price;
+        std::uint32_t quantity;
+        std::array<std::uint8_t, 4> flags;
+        pod_test_inner_struct position;
+        std::uint8_t extra;
+    };
+
+}
+
+
+namespace serialpp {
+
+    template<>
+    inline constexpr bool enable_pod_layout<test::pod_test_record, test::pod_test_struct> = true;
+
+    template<>
+    inline constexpr bool enable_pod_layout<test::pod_test_bool_record, test::pod_test_bool_struct> = true;
+
+    template<>
+    inline constexpr bool enable_pod_layout<test::pod_test_dynamic_record, test::pod_test_dynamic_struct> = true;
+
+    template<>
+    inline constexpr bool enable_pod_layout<test::pod_test_record, test::pod_test_padded_struct> = true;
+
+}
+
+
+namespace serialpp::test {
+test_block pod_layout_tests = [] {
+
+    static_assert(pod_layout_of<pod_test_struct, pod_test_record> == detail::is_little_endian);
+    static_assert(!pod_layout_of<pod_test_inner_struct, pod_test_inner_record>);     // Not enabled.
+    static_assert(!pod_layout_of<pod_test_bool_struct, pod_test_bool_record>);       // bool isn't a plain copy.
+    static_assert(!pod_layout_of<pod_test_dynamic_struct, pod_test_dynamic_record>); // Has variable data.
+    static_assert(!pod_layout_of<pod_test_padded_struct, pod_test_record>);          // Size mismatch.
+
+    if constexpr (detail::is_little_endian) {
+        static constexpr pod_test_struct value{
+            1'234'567'890'123ull,
+            -5.25,
+            4'000'000'000u,
+            {1, 2, 3, 4},
+            {-7, 1'000'000}
+        };
+
+        static constexpr serialise_source<pod_test_record> source{
+            1'234'567'890'123ull,
+            -5.25,
+            4'000'000'000u,
+            {{1, 2, 3, 4}},
+            {-7, 1'000'000}
+        };
+
+        test_case("serialise_pod() same as serialise()") = [] {
+            basic_buffer expected_buffer;
+            serialise(source, expected_buffer);
+
+            basic_buffer buffer;
+            serialise_pod<pod_test_record>(value, buffer);
+
+            test_assert(std::ranges::equal(buffer.span(), expected_buffer.span()));
+        };
+
+        test_case("serialise_pod() at offset") = [] {
+            std::array<std::byte, 50> expected_buffer{};
+            serialise<pod_test_record>(source, mutable_bytes_span{expected_buffer}, 10);
+
+            std::array<std::byte, 50> buffer{};
+            serialise_pod<pod_test_record>(value, mutable_bytes_span{buffer}, 10);
+
+            test_assert(buffer == expected_buffer);
+        };
+
+        test_case("serialise_pod() constexpr") = [] {
+            constexpr auto buffer = [] {
+                std::array<std::byte, fixed_data_size_v<pod_test_record>> buffer{};
+                serialise_pod<pod_test_record>(value, mutable_bytes_span{buffer}, 0);
+                return buffer;
+            }();
+            std::array<std::byte, fixed_data_size_v<pod_test_record>> expected_buffer{};
+            serialise<pod_test_record>(source, mutable_bytes_span{expected_buffer}, 0);
+
+            test_assert(buffer == expected_buffer);
+        };
+
+        test_case("deserialise_into()") = [] {
+            std::array<std::byte, 50> buffer{};
+            serialise<pod_test_record>(source, mutable_bytes_span{buffer}, 6);
+
+            pod_test_struct output{};
+            deserialise_into<pod_test_record>(const_bytes_span{buffer}, output, 6);
+
+            test_assert(output.timestamp == value.timestamp);
+            test_assert(output.price == value.price);
+            test_assert(output.quantity == value.quantity);
+            test_assert(output.flags == value.flags);
+            test_assert(output.position.x == value.position.x);
+            test_assert(output.position.y == value.position.y);
+        };
+
+        test_case("deserialise_into() constexpr") = [] {
+            constexpr auto output = [] {
+                std::array<std::byte, fixed_data_size_v<pod_test_record>> buffer{};
+                serialise<pod_test_record>(source, mutable_bytes_span{buffer}, 0);
+                pod_test_struct output{};
+                deserialise_into<pod_test_record>(const_bytes_span{buffer}, output);
+                return output;
+            }();
+
+            test_assert(output.timestamp == value.timestamp);
+            test_assert(output.quantity == value.quantity);
+            test_assert(output.position.y == value.position.y);
+        };
+
+        test_case("deserialise_into() buffer too small") = [] {
+            std::array<std::byte, fixed_data_size_v<pod_test_record> + 2> const buffer{};
+            pod_test_struct output{};
+            test_assert_throws<buffer_bounds_error>([&buffer, &output] {
+                deserialise_into<pod_test_record>(const_bytes_span{buffer}, output, 3);
+            });
+        };
+    }
+
+};
+}
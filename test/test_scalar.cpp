@@ -4,7 +4,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 #include <string>
+#include <vector>
 
 #include <serialpp/buffers.hpp>
 #include <serialpp/common.hpp>
@@ -249,6 +251,19 @@ test_block scalar_tests = [] {
     }
 
 
+    static_assert(detail::byte_swap(std::uint8_t{0x12}) == 0x12);
+    static_assert(detail::byte_swap(std::uint16_t{0x1234}) == 0x3412);
+    static_assert(detail::byte_swap(std::uint32_t{0x12345678}) == 0x78563412);
+    static_assert(detail::byte_swap(std::uint64_t{0x0123456789ABCDEF}) == 0xEFCDAB8967452301);
+
+    test_case("serialise_scalars() empty range") = [] {
+        // An empty range's data pointer may be null, which must not be passed to memcpy.
+        std::array<std::byte, 4> buffer{};
+        detail::serialise_scalars<std::uint32_t>(std::vector<std::uint32_t>{}, std::span{buffer}, 4);
+        detail::serialise_scalars<std::uint32_t>(std::span<std::uint32_t const>{}, std::span{buffer}, 0);
+        test_assert(buffer == std::array<std::byte, 4>{});
+    };
+
     test_case("auto_deserialise() scalar") = [] {
         std::array<unsigned char, 100> const buffer{0x01, 0x23, 0x45, 0x67, 0x11, 0x22, 0x33};
         deserialiser<std::uint32_t> const deser{as_const_bytes_span(buffer), 0};
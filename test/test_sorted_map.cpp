@@ -0,0 +1,206 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/sorted_map.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block sorted_map_tests = [] {
+
+    static_assert(variable_size_serialisable<sorted_map<std::int32_t, double>>);
+    static_assert(size_precomputable<sorted_map<std::int32_t, dynamic_array<std::uint8_t>>>);
+    static_assert(validatable<sorted_map<std::int32_t, dynamic_array<std::uint8_t>>>);
+    static_assert(fixed_data_size_v<sorted_map<std::int32_t, double>> == 4 + 4 + 4);
+    static_assert(fixed_data_size_v<large_sorted_map<std::int32_t, double>> == 8 + 8 + 8);
+
+    static_assert(std::ranges::view<sorted_map_view<std::int32_t, double>>);
+    static_assert(std::ranges::random_access_range<sorted_map_view<std::int32_t, double>>);
+    static_assert(std::ranges::borrowed_range<sorted_map_view<std::int32_t, double>>);
+
+    test_case("serialise() sorted_map") = [] {
+        using type = sorted_map<std::uint16_t, std::uint8_t>;
+        serialise_source<type> const source{{{300, 3}, {10, 1}, {200, 2}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 21> const expected_buffer{
+            0x03, 0x00, 0x00, 0x00,     // Size
+            0x0C, 0x00, 0x00, 0x00,     // Keys offset
+            0x12, 0x00, 0x00, 0x00,     // Values offset
+            0x0A, 0x00,                 // Key 10
+            0xC8, 0x00,                 // Key 200
+            0x2C, 0x01,                 // Key 300
+            0x01, 0x02, 0x03            // Values
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 3);
+        test_assert(deser.find(200) == 2);
+        test_assert(!deser.find(100));
+        test_assert(deser.contains(10));
+        test_assert(!deser.contains(301));
+        test_assert(deser.at(300) == 3);
+    };
+
+    test_case("serialise() sorted_map empty") = [] {
+        using type = sorted_map<std::int32_t, double>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 12> const expected_buffer{};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.empty());
+        test_assert(!deser.find(0));
+        test_assert(deser.entries().begin() == deser.entries().end());
+    };
+
+    test_case("serialise_source sorted_map from std::map and std::unordered_map") = [] {
+        using type = sorted_map<std::int64_t, std::int32_t>;
+        std::unordered_map<std::int64_t, std::int32_t> const unordered{{5, -5}, {-3, 3}, {100, -100}, {0, 0}};
+        std::map<std::int64_t, std::int32_t> const ordered(unordered.begin(), unordered.end());
+
+        basic_buffer unordered_buffer;
+        serialise(serialise_source<type>{unordered}, unordered_buffer);
+        basic_buffer ordered_buffer;
+        serialise(serialise_source<type>{ordered}, ordered_buffer);
+        test_assert(std::ranges::equal(unordered_buffer.span(), ordered_buffer.span()));
+
+        auto const deser = validate<type>(ordered_buffer.span());
+        std::vector<std::pair<std::int64_t, std::int32_t>> entries;
+        for (auto const [key, value] : deser.entries()) {
+            entries.emplace_back(key, value);
+        }
+        test_assert(entries == std::vector<std::pair<std::int64_t, std::int32_t>>(ordered.begin(), ordered.end()));
+    };
+
+    test_case("serialise_source sorted_map duplicate keys") = [] {
+        using type = sorted_map<std::int32_t, std::int32_t>;
+        test_assert_throws<std::invalid_argument>([] {
+            serialise_source<type> const source{{{1, 1}, {2, 2}, {1, 3}}};
+        });
+    };
+
+    test_case("serialiser sorted_map variable_data_size()") = [] {
+        using type = sorted_map<std::uint32_t, dynamic_array<std::uint8_t>>;
+        using bytes = serialise_source<dynamic_array<std::uint8_t>>;
+        serialise_source<type> const source{{{2, bytes{{1, 2, 3}}}, {1, bytes{}}}};
+        test_assert(variable_data_size<type>(source) == 2 * 4 + 2 * 8 + 3);
+    };
+
+    test_case("sorted_map_view lower_bound(), upper_bound() and find()") = [] {
+        using type = sorted_map<std::int32_t, std::int32_t>;
+        std::vector<std::pair<serialise_source<std::int32_t>, serialise_source<std::int32_t>>> source_entries;
+        for (std::int32_t i = 0; i < 1000; ++i) {
+            source_entries.emplace_back(i * 3, -i);
+        }
+        serialise_source<type> const source{std::move(source_entries)};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const entries = validate<type>(buffer.span()).entries();
+        test_assert(entries.size() == 1000);
+        test_assert(entries.lower_bound(-1) == entries.begin());
+        test_assert(entries.lower_bound(30) - entries.begin() == 10);
+        test_assert(entries.lower_bound(31) - entries.begin() == 11);
+        test_assert(entries.upper_bound(30) - entries.begin() == 11);
+        test_assert(entries.lower_bound(3000) == entries.end());
+        test_assert(entries.find(31) == entries.end());
+        test_assert(entries.find(2997).value() == -999);
+        test_assert(entries.find(std::int64_t{150}).key() == 150);
+        for (std::int32_t i = 0; i < 1000; i += 7) {
+            test_assert(entries.find(i * 3).value() == -i);
+        }
+        test_assert(entries.keys()[1] == 3);
+        test_assert(entries.values()[1] == -1);
+    };
+
+    test_case("sorted_map_view find() iterator outlives view") = [] {
+        using type = sorted_map<std::int32_t, std::int32_t>;
+        basic_buffer buffer;
+        serialise(serialise_source<type>{{{1, 10}, {3, 30}, {2, 20}}}, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        // The view is a temporary, which is destroyed before the iterator is used.
+        auto it = deser.entries().find(2);
+        test_assert(it.value() == 20);
+        ++it;
+        test_assert(it.key() == 3);
+        test_assert(it.value() == 30);
+    };
+
+    test_case("sorted_map with custom Compare") = [] {
+        using type = sorted_map<std::uint8_t, std::uint8_t, std::greater<>>;
+        serialise_source<type> const source{{{1, 10}, {3, 30}, {2, 20}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(std::ranges::equal(deser.entries().keys(), std::array{3, 2, 1}));
+        test_assert(deser.at(2) == 20);
+    };
+
+    test_case("sorted_map with variable size values") = [] {
+        using type = sorted_map<std::uint32_t, dynamic_array<std::uint8_t>>;
+        using bytes = serialise_source<dynamic_array<std::uint8_t>>;
+        serialise_source<type> const source{{{7, bytes{{1, 2}}}, {4, bytes{{3}}}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.at(4).to_vector() == std::vector<std::uint8_t>{3});
+        test_assert(deser.at(7).to_vector() == std::vector<std::uint8_t>{1, 2});
+        test_assert_throws<std::out_of_range>([&deser] {
+            (void)deser.at(5);
+        });
+    };
+
+    test_case("validate() sorted_map keys out of order") = [] {
+        std::array<unsigned char, 18> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Size
+            0x0C, 0x00, 0x00, 0x00,     // Keys offset
+            0x10, 0x00, 0x00, 0x00,     // Values offset
+            0x02, 0x00,                 // Keys
+            0x01, 0x00,
+            0x05, 0x06                  // Values
+        };
+        using type = sorted_map<std::uint16_t, std::uint8_t>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("validate() sorted_map values out of bounds") = [] {
+        std::array<unsigned char, 17> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Size
+            0x0C, 0x00, 0x00, 0x00,     // Keys offset
+            0x10, 0x00, 0x00, 0x00,     // Values offset
+            0x01, 0x00,                 // Keys
+            0x02, 0x00,
+            0x05                        // Values (should be 2 bytes)
+        };
+        using type = sorted_map<std::uint16_t, std::uint8_t>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+};
+}
@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -28,6 +30,9 @@ test_block static_array_tests = [] {
     static_assert(std::semiregular<serialise_source<static_array<std::int32_t, 0>>>);
     static_assert(std::semiregular<serialise_source<static_array<std::int32_t, 5>>>);
 
+    static_assert(size_precomputable<static_array<mock_serialisable<12, true>, 0>>);
+    static_assert(!size_precomputable<static_array<mock_serialisable<12, true>, 3>>);
+
     test_case("serialiser static_array empty") = [] {
         using type = static_array<std::uint64_t, 0>;
         basic_buffer buffer;
@@ -130,5 +135,94 @@ test_block static_array_tests = [] {
         }
     };
 
+    test_case("deserialiser static_array elements_span() aligned") = [] {
+        alignas(8) std::array<unsigned char, 16> const buffer{
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // element 0
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0xFE, 0xC0      // element 1
+        };
+        using type = static_array<double, 2>;
+        auto const buffer_span = as_const_bytes_span(buffer);
+        deserialiser<type> const deser{buffer_span, 0};
+        std::array<double, 2> const expected_elements{0.0, -123456.0};
+
+        auto const span = deser.elements_span();
+        std::array<double, 2> fallback_storage{};
+        auto const fallback_span = deser.elements_span(fallback_storage);
+        if constexpr (std::endian::native == std::endian::little) {
+            test_assert(span.has_value());
+            test_assert(static_cast<void const*>(span->data()) == buffer_span.data());
+            test_assert(std::ranges::equal(*span, expected_elements));
+            test_assert(fallback_span.data() == span->data());
+        }
+        else {
+            test_assert(!span.has_value());
+        }
+        test_assert(std::ranges::equal(fallback_span, expected_elements));
+    };
+
+    test_case("deserialiser static_array elements_span() misaligned") = [] {
+        alignas(8) std::array<unsigned char, 11> const buffer{
+            0x01, 0x02, 0x03,       // Dummy padding
+            0x0C, 0x00,             // element 0
+            0x2D, 0x00,             // element 1
+            0xD1, 0x01,             // element 2
+            0x43, 0x60              // element 3
+        };
+        using type = static_array<std::uint16_t, 4>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 3};
+        test_assert(!deser.elements_span().has_value());
+
+        std::array<std::uint16_t, 4> fallback_storage{};
+        auto const span = deser.elements_span(fallback_storage);
+        test_assert(span.data() == fallback_storage.data());
+        test_assert(std::ranges::equal(span, std::array<std::uint16_t, 4>{12, 45, 465, 24643}));
+    };
+
+    test_case("deserialiser static_array copy_to()") = [] {
+        alignas(8) std::array<unsigned char, 11> const buffer{
+            0x01, 0x02, 0x03,       // Dummy padding
+            0x0C, 0x00,             // element 0
+            0x2D, 0x00,             // element 1
+            0xD1, 0x01,             // element 2
+            0x43, 0x60              // element 3
+        };
+        using type = static_array<std::uint16_t, 4>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 3};
+
+        std::array<std::uint16_t, 6> output{};
+        auto const written = deser.copy_to(std::span{output});
+        test_assert(written.data() == output.data());
+        test_assert(std::ranges::equal(written, std::array<std::uint16_t, 4>{12, 45, 465, 24643}));
+        test_assert(output[4] == 0 && output[5] == 0);
+
+        // Widening.
+        std::array<std::uint64_t, 4> wide_output{};
+        (void)deser.copy_to(std::span{wide_output});
+        test_assert(wide_output == std::array<std::uint64_t, 4>{12, 45, 465, 24643});
+
+        test_assert(deser.to_array() == std::array<std::uint16_t, 4>{12, 45, 465, 24643});
+        test_assert(deser.to_array<std::int32_t>() == std::array<std::int32_t, 4>{12, 45, 465, 24643});
+
+        std::array<std::uint16_t, 3> small_output{};
+        test_assert_throws<std::out_of_range>([&deser, &small_output] {
+            (void)deser.copy_to(std::span<std::uint16_t>{small_output});
+        });
+    };
+
+    test_case("deserialiser static_array copy_to() constexpr") = [] {
+        []() consteval {
+            std::array<unsigned char, 8> const buffer{
+                0x0C, 0x00,             // element 0
+                0x2D, 0x00,             // element 1
+                0xD1, 0x01,             // element 2
+                0x43, 0x60              // element 3
+            };
+            auto const buffer_bytes = uchar_array_to_bytes(buffer);
+            using type = static_array<std::uint16_t, 4>;
+            deserialiser<type> const deser{const_bytes_span{buffer_bytes}, 0};
+            test_assert(deser.to_array<std::uint32_t>() == std::array<std::uint32_t, 4>{12, 45, 465, 24643});
+        }();
+    };
+
 };
 }
@@ -0,0 +1,148 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/hash_map.hpp>
+#include <serialpp/sorted_map.hpp>
+#include <serialpp/string.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+using namespace std::literals;
+
+
+namespace serialpp::test {
+test_block string_tests = [] {
+
+    static_assert(variable_size_serialisable<string<>>);
+    static_assert(size_precomputable<string<>>);
+    static_assert(validatable<string<>>);
+    static_assert(fixed_data_size_v<string<>> == 4 + 4);
+    static_assert(fixed_data_size_v<large_string> == 8 + 8);
+    static_assert(std::same_as<deserialise_t<string<>>, std::string_view>);
+
+    static_assert(stable_hash<string<>>{}(""sv) == 0);
+    static_assert(stable_hash<string<>>{}("abc"sv) != stable_hash<string<>>{}("abd"sv));
+    static_assert(stable_hash<string<>>{}("abcdefgh"sv) != stable_hash<string<>>{}("abcdefgh\0"sv));
+
+    test_case("serialise() string") = [] {
+        using type = string<>;
+        serialise_source<type> const source{"hello"};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 13> const expected_buffer{
+            0x05, 0x00, 0x00, 0x00,         // Size
+            0x08, 0x00, 0x00, 0x00,         // Offset
+            'h', 'e', 'l', 'l', 'o'         // Characters
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const value = deserialise<type>(buffer.span());
+        test_assert(value == "hello");
+        test_assert(reinterpret_cast<std::byte const*>(value.data()) == buffer.span().data() + 8);
+    };
+
+    test_case("serialise() string empty") = [] {
+        using type = string<>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 8> const expected_buffer{};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        test_assert(validate<type>(buffer.span()).empty());
+    };
+
+    test_case("string same representation as dynamic_array<char>") = [] {
+        std::string const chars(1000, 'x');
+        basic_buffer string_buffer;
+        serialise(serialise_source<large_string>{chars}, string_buffer);
+        basic_buffer array_buffer;
+        serialise(serialise_source<large_dynamic_array<char>>{chars}, array_buffer);
+        test_assert(std::ranges::equal(string_buffer.span(), array_buffer.span()));
+        test_assert(variable_data_size<large_string>(serialise_source<large_string>{chars}) == 1000);
+
+        test_assert(validate<large_string>(array_buffer.span()) == chars);
+    };
+
+    test_case("deserialiser string") = [] {
+        using type = string<>;
+        basic_buffer buffer;
+        serialise(serialise_source<type>{"abc\0def"sv}, buffer);
+
+        deserialiser<type> const deser{buffer.span(), 0};
+        test_assert(deser.size() == 7);
+        test_assert(!deser.empty());
+        test_assert(deser.value() == "abc\0def"sv);
+    };
+
+    test_case("string in dynamic_array") = [] {
+        using type = dynamic_array<string<>>;
+        serialise_source<type> const source{{"one", "", "three"}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == 3);
+        test_assert(deser[0] == "one");
+        test_assert(deser[1].empty());
+        test_assert(deser[2] == "three");
+    };
+
+    test_case("string as sorted_map key") = [] {
+        using type = sorted_map<string<>, std::uint32_t>;
+        serialise_source<type> const source{{{"pear", 3}, {"apple", 1}, {"orange", 2}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.entries().keys()[0] == "apple");
+        test_assert(deser.find("orange"sv) == 2);
+        test_assert(deser.at(std::string{"pear"}) == 3);
+        test_assert(!deser.contains("banana"sv));
+    };
+
+    test_case("string as hash_map key") = [] {
+        using type = hash_map<string<>, std::int32_t>;
+        std::unordered_map<std::string, std::int32_t> entries;
+        for (std::int32_t i = 0; i < 500; ++i) {
+            entries.emplace("symbol" + std::to_string(i), i);
+        }
+        serialise_source<type> const source{entries};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        for (auto const& [key, value] : entries) {
+            test_assert(deser.find(key) == value);
+        }
+        test_assert(!deser.contains("symbol500"sv));
+    };
+
+    test_case("deserialise() string out of bounds") = [] {
+        std::array<unsigned char, 12> const buffer{
+            0x05, 0x00, 0x00, 0x00,     // Size
+            0x08, 0x00, 0x00, 0x00,     // Offset
+            'a', 'b', 'c', 'd'          // Characters (should be 5)
+        };
+        using type = string<>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)deserialise<type>(as_const_bytes_span(buffer));
+        });
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+};
+}
@@ -22,6 +22,12 @@ test_block variant_tests = [] {
     static_assert(variable_size_serialisable<variant<char, mock_serialisable<57>>>);
     static_assert(fixed_data_size_v<variant<>> == 2 + 4);
     static_assert(fixed_data_size_v<variant<std::uint8_t, mock_serialisable<100>, std::int32_t>> == 2 + 4);
+    static_assert(fixed_data_size_v<large_variant<>> == 2 + 8);
+    static_assert(fixed_data_size_v<large_variant<std::uint8_t, std::int32_t>> == 2 + 8);
+
+    static_assert(size_precomputable<variant<>>);
+    static_assert(size_precomputable<variant<std::uint8_t, std::int32_t>>);
+    static_assert(!size_precomputable<variant<std::uint8_t, mock_serialisable<100>>>);
 
     test_case("serialiser variant empty serialise_buffer") = [] {
         basic_buffer buffer;
@@ -83,6 +89,12 @@ test_block variant_tests = [] {
         test_assert(buffer_equal(buffer, expected_buffer));
     };
 
+    test_case("serialiser variant variable_data_size()") = [] {
+        using type = variant<std::uint8_t, std::int64_t>;
+        test_assert(serialiser<type>::variable_data_size(serialise_source<type>{std::in_place_index<0>, 12}) == 1);
+        test_assert(serialiser<type>::variable_data_size(serialise_source<type>{std::in_place_index<1>, -3}) == 8);
+    };
+
     test_case("deserialiser variant empty") = [] {
         std::array<unsigned char, 6> const buffer{
             0x00, 0x00,                 // Type index
@@ -163,5 +175,62 @@ test_block variant_tests = [] {
         });
     };
 
+    test_case("validate() variant scalars") = [] {
+        std::array<unsigned char, 24> const buffer{
+            0x02, 0x00,                 // Type index
+            0x10, 0x00, 0x00, 0x00,     // Value offset
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,     // Dummy padding
+            0x6E, 0x86, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00      // Value
+        };
+        using type = variant<std::uint32_t, std::uint8_t, std::int64_t>;
+        deserialiser<type> const deser = validate<type>(as_const_bytes_span(buffer));
+        test_assert(deser.index() == 2);
+        test_assert(deser.get<2>() == 3'245'678);
+    };
+
+    test_case("validate() variant value partially out of bounds") = [] {
+        std::array<unsigned char, 24> const buffer{
+            0x02, 0x00,                 // Type index
+            0x13, 0x00, 0x00, 0x00,     // Value offset
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A,     // Dummy padding
+            0x6E, 0x86, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00      // Value
+        };
+        using type = variant<std::uint32_t, std::uint8_t, std::int64_t>;
+        test_assert_throws<buffer_bounds_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("validate() variant type index out of range") = [] {
+        std::array<unsigned char, 10> const buffer{
+            0x03, 0x00,                 // Type index
+            0x06, 0x00, 0x00, 0x00,     // Value offset
+            0x6E, 0x86, 0x31, 0x00      // Value
+        };
+        using type = variant<std::uint32_t, std::uint8_t, std::int64_t>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("serialise() large_variant") = [] {
+        using type = large_variant<std::uint8_t, std::uint16_t>;
+        serialise_source<type> const source{std::in_place_index<1>, 0x1234};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 12> const expected_buffer{
+            0x01, 0x00,                                         // Type index
+            0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,     // Value offset
+            0x34, 0x12                                          // Value
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.index() == 1);
+        test_assert(deser.get<1>() == 0x1234);
+        (void)validate<type>(buffer.span());
+    };
+
 };
 }
\ No newline at end of file
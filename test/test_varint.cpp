@@ -0,0 +1,226 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <serialpp/buffers.hpp>
+#include <serialpp/common.hpp>
+#include <serialpp/dynamic_array.hpp>
+#include <serialpp/varint.hpp>
+
+#include "helpers/buffer_utility.hpp"
+#include "helpers/test.hpp"
+
+
+namespace serialpp::test {
+test_block varint_tests = [] {
+
+    static_assert(varint_encoding<varint<std::uint32_t>>);
+    static_assert(varint_encoding<zigzag<std::int64_t>>);
+    static_assert(variable_size_serialisable<packed_dynamic_array<varint<std::uint32_t>>>);
+    static_assert(size_precomputable<packed_dynamic_array<varint<std::uint32_t>>>);
+    static_assert(validatable<packed_dynamic_array<zigzag<std::int16_t>>>);
+    static_assert(fixed_data_size_v<packed_dynamic_array<varint<std::uint64_t>>> == 4 + 4 + 4);
+    static_assert(fixed_data_size_v<packed_dynamic_array<varint<std::uint64_t>, large_format>> == 8 + 8 + 8);
+
+    static_assert(std::ranges::view<packed_dynamic_array_view<varint<std::uint16_t>>>);
+    static_assert(std::ranges::forward_range<packed_dynamic_array_view<varint<std::uint16_t>>>);
+    static_assert(std::ranges::borrowed_range<packed_dynamic_array_view<varint<std::uint16_t>>>);
+
+    static_assert(zigzag<std::int32_t>::encode(0) == 0);
+    static_assert(zigzag<std::int32_t>::encode(-1) == 1);
+    static_assert(zigzag<std::int32_t>::encode(1) == 2);
+    static_assert(zigzag<std::int32_t>::encode(-2) == 3);
+    static_assert(zigzag<std::int8_t>::encode(std::numeric_limits<std::int8_t>::min()) == 0xFF);
+    static_assert(zigzag<std::int64_t>::decode(zigzag<std::int64_t>::encode(std::numeric_limits<std::int64_t>::min()))
+        == std::numeric_limits<std::int64_t>::min());
+    static_assert(zigzag<std::int64_t>::decode(zigzag<std::int64_t>::encode(std::numeric_limits<std::int64_t>::max()))
+        == std::numeric_limits<std::int64_t>::max());
+
+    static_assert(detail::varint_size(0u) == 1);
+    static_assert(detail::varint_size(127u) == 1);
+    static_assert(detail::varint_size(128u) == 2);
+    static_assert(detail::varint_size(std::numeric_limits<std::uint64_t>::max()) == 10);
+
+    test_case("serialise() packed_dynamic_array varint") = [] {
+        using type = packed_dynamic_array<varint<std::uint32_t>>;
+        serialise_source<type> const source{{5, 127, 128, 300, 0xFFFFFFFF}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 23> const expected_buffer{
+            0x05, 0x00, 0x00, 0x00,         // Size
+            0x0B, 0x00, 0x00, 0x00,         // Byte size
+            0x0C, 0x00, 0x00, 0x00,         // Offset
+            0x05,                           // 5
+            0x7F,                           // 127
+            0x80, 0x01,                     // 128
+            0xAC, 0x02,                     // 300
+            0xFF, 0xFF, 0xFF, 0xFF, 0x0F    // 0xFFFFFFFF
+        };
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.size() == 5);
+        test_assert(deser.to_vector() == std::vector<std::uint32_t>{5, 127, 128, 300, 0xFFFFFFFF});
+    };
+
+    test_case("serialise() packed_dynamic_array empty") = [] {
+        using type = packed_dynamic_array<zigzag<std::int32_t>>;
+        serialise_source<type> const source;
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        std::array<unsigned char, 12> const expected_buffer{};
+        test_assert(buffer_equal(buffer, expected_buffer));
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.empty());
+        test_assert(deser.to_vector().empty());
+        test_assert(deser.elements().begin() == deser.elements().end());
+    };
+
+    test_case("serialiser packed_dynamic_array variable_data_size()") = [] {
+        using type = packed_dynamic_array<zigzag<std::int16_t>>;
+        serialise_source<type> const source{{0, -64, 64, -8192, 8192}};
+        test_assert(variable_data_size<type>(source) == 1 + 1 + 2 + 2 + 3);
+    };
+
+    test_case("packed_dynamic_array zigzag round trip") = [] {
+        using type = packed_dynamic_array<zigzag<std::int64_t>>;
+        std::vector<std::int64_t> elements;
+        for (std::int64_t i = -1000; i < 1000; i += 7) {
+            elements.push_back(i);
+        }
+        elements.push_back(std::numeric_limits<std::int64_t>::min());
+        elements.push_back(std::numeric_limits<std::int64_t>::max());
+        serialise_source<type> const source{std::span<std::int64_t const>{elements}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser.size() == elements.size());
+        test_assert(deser.to_vector() == elements);
+        test_assert(std::ranges::equal(deser.elements(), elements));
+        // Iterators remain valid after the view is destroyed.
+        auto it = deser.elements().begin();
+        test_assert(*++it == elements[1]);
+    };
+
+    test_case("packed_dynamic_array single byte fast path") = [] {
+        using type = packed_dynamic_array<varint<std::uint16_t>>;
+        std::vector<std::uint16_t> elements;
+        for (std::uint16_t i = 0; i < 100; ++i) {
+            // Mostly small values, with some larger ones breaking up the runs.
+            elements.push_back(i % 13 == 0 ? static_cast<std::uint16_t>(i * 500) : i);
+        }
+        serialise_source<type> const source{std::vector<std::uint16_t>{elements}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = deserialise<type>(buffer.span());
+        test_assert(deser.to_vector<std::uint32_t>() == std::vector<std::uint32_t>(elements.begin(), elements.end()));
+    };
+
+    test_case("packed_dynamic_array in dynamic_array") = [] {
+        using type = dynamic_array<packed_dynamic_array<varint<std::uint32_t>>>;
+        std::vector<std::uint32_t> const first{1, 2, 3};
+        std::vector<std::uint32_t> const second{100'000};
+        serialise_source<type> const source{{std::span{first}, std::span{second}}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = validate<type>(buffer.span());
+        test_assert(deser[0].to_vector() == first);
+        test_assert(deser[1].to_vector() == second);
+        test_assert(deser[1].byte_size() == 3);
+    };
+
+    test_case("serialise() packed_dynamic_array too many bytes") = [] {
+        struct byte_size_format {
+            using offset_type = std::uint32_t;
+            using size_type = std::uint8_t;
+        };
+        using type = packed_dynamic_array<varint<std::uint16_t>, byte_size_format>;
+        // 200 elements fit in the element count, but 400 bytes don't fit in the byte count.
+        std::vector<std::uint16_t> const elements(200, 200);
+        serialise_source<type> const source{std::span{elements}};
+        basic_buffer buffer;
+        buffer.initialise(fixed_data_size_v<type>);
+        test_assert_throws<object_size_error>([&source, &buffer] {
+            serialise(source, buffer, 0);
+        });
+        // The buffer isn't extended if the object is too big.
+        test_assert(buffer.span().size() == fixed_data_size_v<type>);
+    };
+
+    test_case("deserialiser packed_dynamic_array copy_to() output too small") = [] {
+        using type = packed_dynamic_array<varint<std::uint8_t>>;
+        serialise_source<type> const source{{1, 2, 3}};
+        basic_buffer buffer;
+        serialise(source, buffer);
+
+        auto const deser = deserialise<type>(buffer.span());
+        std::array<std::uint8_t, 2> output{};
+        test_assert_throws<std::out_of_range>([&deser, &output] {
+            (void)deser.copy_to(std::span{output});
+        });
+    };
+
+    test_case("deserialiser packed_dynamic_array bytes out of bounds") = [] {
+        std::array<unsigned char, 14> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Size
+            0x03, 0x00, 0x00, 0x00,     // Byte size
+            0x0C, 0x00, 0x00, 0x00,     // Offset
+            0x01, 0x02                  // Elements
+        };
+        using type = packed_dynamic_array<varint<std::uint32_t>>;
+        deserialiser<type> const deser{as_const_bytes_span(buffer), 0};
+        test_assert_throws<buffer_bounds_error>([&deser] {
+            (void)deser.to_vector();
+        });
+    };
+
+    test_case("validate() packed_dynamic_array truncated element") = [] {
+        std::array<unsigned char, 14> const buffer{
+            0x02, 0x00, 0x00, 0x00,     // Size
+            0x02, 0x00, 0x00, 0x00,     // Byte size
+            0x0C, 0x00, 0x00, 0x00,     // Offset
+            0x01, 0x82                  // Elements
+        };
+        using type = packed_dynamic_array<varint<std::uint32_t>>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("validate() packed_dynamic_array element too big") = [] {
+        std::array<unsigned char, 14> const buffer{
+            0x01, 0x00, 0x00, 0x00,     // Size
+            0x02, 0x00, 0x00, 0x00,     // Byte size
+            0x0C, 0x00, 0x00, 0x00,     // Offset
+            0x80, 0x02                  // Element (256)
+        };
+        using type = packed_dynamic_array<varint<std::uint8_t>>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+    test_case("validate() packed_dynamic_array extra bytes") = [] {
+        std::array<unsigned char, 14> const buffer{
+            0x01, 0x00, 0x00, 0x00,     // Size
+            0x02, 0x00, 0x00, 0x00,     // Byte size
+            0x0C, 0x00, 0x00, 0x00,     // Offset
+            0x01, 0x02                  // Elements
+        };
+        using type = packed_dynamic_array<varint<std::uint32_t>>;
+        test_assert_throws<invalid_value_error>([&buffer] {
+            (void)validate<type>(as_const_bytes_span(buffer));
+        });
+    };
+
+};
+}